@@ -121,12 +121,11 @@ void matrix_scan_kb(void) {
         sdReadTimeout(&SD1, (uint8_t *)&ble_capslock, sizeof(ble_capslock_t), 10);
     }
 
-    /* While there's data from LED keyboard sent - read it. */
-    while (!sdGetWouldBlock(&SD0)) {
-        uint8_t byte = sdGet(&SD0);
-        proto_consume(&proto, byte);
-    }
+    /* Read messages from the LED MCU and retransmit lost ones */
+    proto_task(&proto);
 
+    /* Pass queued reports on to the BLE MCU */
+    annepro2_ble_task();
 
     matrix_scan_user();
 }
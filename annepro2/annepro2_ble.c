@@ -14,6 +14,7 @@
     limitations under the License.
 */
 
+#include <string.h>
 #include "annepro2_ble.h"
 #include "ch.h"
 #include "hal.h"
@@ -28,6 +29,8 @@ static void    ap2_ble_extra(report_extra_t *report);
 static void    ap2_ble_keyboard(report_keyboard_t *report);
 
 static void ap2_ble_swtich_ble_driver(void);
+static void ap2_ble_queue_report(uint8_t type, const uint8_t *data);
+static void ap2_ble_clear_queue(void);
 
 /* -------------------- Static Local Variables ------------------------------ */
 static host_driver_t ap2_ble_driver = {
@@ -58,6 +61,26 @@ static uint8_t ble_mcu_unpair[10] = {
 
 static uint8_t ble_mcu_bootload[11] = {0x7b, 0x10, 0x51, 0x10, 0x03, 0x00, 0x00, 0x7d, 0x02, 0x01, 0x01};
 
+enum {
+    AP2_BLE_KEYBOARD,
+    AP2_BLE_CONSUMER,
+    AP2_BLE_REPORT_TYPES,
+};
+
+typedef struct {
+    uint8_t type;
+    uint8_t data[KEYBOARD_REPORT_SIZE];
+} ap2_ble_report_t;
+
+static ap2_ble_report_t ble_queue[AP2_BLE_QUEUE_SIZE];
+static uint8_t          ble_queue_head;
+
+/* Newest report of each type, queued or sent */
+static uint8_t ble_latest[AP2_BLE_REPORT_TYPES][KEYBOARD_REPORT_SIZE];
+
+static systime_t       ble_last_sent;
+static ap2_ble_stats_t ble_stats;
+
 static host_driver_t *last_host_driver = NULL;
 #ifdef NKRO_ENABLE
 static bool lastNkroStatus = false;
@@ -91,6 +114,7 @@ void annepro2_ble_connect(uint8_t port) {
     sdWrite(&SD1, ble_mcu_connect, sizeof(ble_mcu_connect));
     sdPut(&SD1, port);
     sdPut(&SD1, 0x00);
+    ble_stats.port = port;
     ap2_ble_swtich_ble_driver();
 }
 
@@ -105,6 +129,8 @@ void annepro2_ble_disconnect(void) {
     keymap_config.nkro = lastNkroStatus;
 #endif
     host_set_driver(last_host_driver);
+    ble_stats.connected = false;
+    ap2_ble_clear_queue();
 }
 
 void annepro2_ble_unpair(void) {
@@ -112,6 +138,49 @@ void annepro2_ble_unpair(void) {
     sdWrite(&SD1, ble_mcu_unpair, sizeof(ble_mcu_unpair));
 }
 
+/*!
+ * @brief  Send the oldest queued report, if the BLE MCU is ready for it
+ */
+void annepro2_ble_task(void) {
+    if (!ble_stats.queued) {
+        return;
+    }
+
+    /* Don't send faster than the BLE MCU forwards reports */
+    if (chVTTimeElapsedSinceX(ble_last_sent) < TIME_MS2I(AP2_BLE_REPORT_INTERVAL)) {
+        return;
+    }
+
+    const ap2_ble_report_t *report = &ble_queue[ble_queue_head];
+    size_t                  size   = 1 + (report->type == AP2_BLE_KEYBOARD ? sizeof(ble_mcu_send_report) + KEYBOARD_REPORT_SIZE : sizeof(ble_mcu_send_consumer_report) + 4);
+
+    /* Only write what fits in the serial buffer, so sdWrite never waits */
+    osalSysLock();
+    size_t free = oqGetEmptyI(&SD1.oqueue);
+    osalSysUnlock();
+    if (free < size) {
+        return;
+    }
+
+    sdPut(&SD1, 0x0);
+    if (report->type == AP2_BLE_KEYBOARD) {
+        sdWrite(&SD1, ble_mcu_send_report, sizeof(ble_mcu_send_report));
+        sdWrite(&SD1, report->data, KEYBOARD_REPORT_SIZE);
+    } else {
+        sdWrite(&SD1, ble_mcu_send_consumer_report, sizeof(ble_mcu_send_consumer_report));
+        sdPut(&SD1, report->data[0]);
+        static const uint8_t dummy[3] = {0};
+        sdWrite(&SD1, dummy, sizeof(dummy));
+    }
+
+    ble_queue_head = (ble_queue_head + 1) % AP2_BLE_QUEUE_SIZE;
+    ble_stats.queued--;
+    ble_stats.sent++;
+    ble_last_sent = chVTGetSystemTimeX();
+}
+
+const ap2_ble_stats_t *annepro2_ble_stats(void) { return &ble_stats; }
+
 /* ------------------- Static Function Implementation ----------------------- */
 static void ap2_ble_swtich_ble_driver(void) {
     if (host_get_driver() == &ap2_ble_driver) {
@@ -123,7 +192,52 @@ static void ap2_ble_swtich_ble_driver(void) {
     lastNkroStatus = keymap_config.nkro;
 #endif
     keymap_config.nkro = false;
+    ap2_ble_clear_queue();
     host_set_driver(&ap2_ble_driver);
+    ble_stats.connected = true;
+}
+
+static void ap2_ble_clear_queue(void) {
+    ble_stats.queued = 0;
+    /* The host starts out with nothing pressed */
+    memset(ble_latest, 0, sizeof(ble_latest));
+}
+
+static void ap2_ble_queue_report(uint8_t type, const uint8_t *data) {
+    /* Reports are state, repeating one changes nothing for the host */
+    if (!memcmp(ble_latest[type], data, KEYBOARD_REPORT_SIZE)) {
+        ble_stats.duplicates++;
+        return;
+    }
+    memcpy(ble_latest[type], data, KEYBOARD_REPORT_SIZE);
+
+    if (ble_stats.queued == AP2_BLE_QUEUE_SIZE) {
+        /* Full: the newest pending report of this type is superseded. Only
+         * done under pressure, as replacing a press with its release would
+         * lose the keystroke. */
+        for (uint8_t i = AP2_BLE_QUEUE_SIZE; i-- > 0;) {
+            ap2_ble_report_t *pending = &ble_queue[(ble_queue_head + i) % AP2_BLE_QUEUE_SIZE];
+            if (pending->type == type) {
+                memcpy(pending->data, data, KEYBOARD_REPORT_SIZE);
+                ble_stats.coalesced++;
+                return;
+            }
+        }
+
+        ble_queue_head = (ble_queue_head + 1) % AP2_BLE_QUEUE_SIZE;
+        ble_stats.queued--;
+        ble_stats.dropped++;
+    }
+
+    ap2_ble_report_t *report = &ble_queue[(ble_queue_head + ble_stats.queued) % AP2_BLE_QUEUE_SIZE];
+    report->type             = type;
+    memcpy(report->data, data, KEYBOARD_REPORT_SIZE);
+    if (++ble_stats.queued > ble_stats.max_queued) {
+        ble_stats.max_queued = ble_stats.queued;
+    }
+
+    /* Send right away when the link is idle */
+    annepro2_ble_task();
 }
 
 static uint8_t ap2_ble_leds(void) {
@@ -153,19 +267,12 @@ static inline uint16_t CONSUMER2AP2(uint16_t usage) {
 
 static void ap2_ble_extra(report_extra_t *report) {
     if (report->report_id == REPORT_ID_CONSUMER) {
-        sdPut(&SD1, 0x0);
-        sdWrite(&SD1, ble_mcu_send_consumer_report, sizeof(ble_mcu_send_consumer_report));
-        sdPut(&SD1, CONSUMER2AP2(report->usage));
-        static const uint8_t dummy[3] = {0};
-        sdWrite(&SD1, dummy, sizeof(dummy));
+        uint8_t data[KEYBOARD_REPORT_SIZE] = {CONSUMER2AP2(report->usage)};
+        ap2_ble_queue_report(AP2_BLE_CONSUMER, data);
     }
 }
 
 /*!
- * @brief  Send keyboard HID report for Bluetooth driver
+ * @brief  Queue keyboard HID report for Bluetooth driver
  */
-static void ap2_ble_keyboard(report_keyboard_t *report) {
-    sdPut(&SD1, 0x0);
-    sdWrite(&SD1, ble_mcu_send_report, sizeof(ble_mcu_send_report));
-    sdWrite(&SD1, (uint8_t *)report, KEYBOARD_REPORT_SIZE);
-}
+static void ap2_ble_keyboard(report_keyboard_t *report) { ap2_ble_queue_report(AP2_BLE_KEYBOARD, (uint8_t *)report); }
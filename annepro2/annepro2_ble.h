@@ -18,9 +18,32 @@
 
 #include "annepro2.h"
 
+/* Reports waiting for the BLE MCU */
+#ifndef AP2_BLE_QUEUE_SIZE
+#    define AP2_BLE_QUEUE_SIZE 16
+#endif
+/* Minimum time between two reports to the BLE MCU, in ms */
+#ifndef AP2_BLE_REPORT_INTERVAL
+#    define AP2_BLE_REPORT_INTERVAL 5
+#endif
+
+typedef struct {
+    bool     connected;  /* BLE is the active host driver */
+    uint8_t  port;       /* last port connected to */
+    uint8_t  queued;     /* reports waiting to be sent */
+    uint8_t  max_queued; /* most reports ever waiting */
+    uint32_t sent;
+    uint32_t duplicates; /* same as the previous report of its type, skipped */
+    uint32_t coalesced;  /* replaced by a newer report while the queue was full */
+    uint32_t dropped;
+} ap2_ble_stats_t;
+
 void annepro2_ble_bootload(void);
 void annepro2_ble_startup(void);
 void annepro2_ble_broadcast(uint8_t port);
 void annepro2_ble_connect(uint8_t port);
 void annepro2_ble_disconnect(void);
 void annepro2_ble_unpair(void);
+void annepro2_ble_task(void);
+
+const ap2_ble_stats_t *annepro2_ble_stats(void);
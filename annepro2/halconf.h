@@ -25,6 +25,9 @@
 
 #define SERIAL_USB_BUFFERS_SIZE 256
 
+/* Large enough to queue several LED rows so RGB flushes never block on the UART */
+#define SERIAL_BUFFERS_SIZE 256
+
 #define HAL_USE_SPI TRUE
 #define SPI_USE_WAIT TRUE
 #define SPI_SELECT_MODE SPI_SELECT_MODE_PAD
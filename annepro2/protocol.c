@@ -10,8 +10,14 @@
  *
  * At 115200, transmitting the shortest message takes 0.043ms, at 9600 - 0.52ms.
  *
+ * With PROTOCOL_ACK_ENABLE every message carries a trailing CRC-8 and is
+ * acknowledged by the receiver. Up to PROTOCOL_WINDOW_SIZE messages can be in
+ * flight; each one is retransmitted on its own after a NACK or a timeout,
+ * instead of blindly sending everything `retries` times. Both ends must be
+ * built with the same setting.
  */
 
+#include <string.h>
 #include "protocol.h"
 #include "board.h"
 #include "ch.h"
@@ -20,28 +26,184 @@
 /* UART communication protocol state */
 protocol_t proto;
 
+#ifdef PROTOCOL_ACK_ENABLE
+/* A sent message waiting for its ACK */
+typedef struct {
+    message_t msg;
+    systime_t sent_at;
+    uint8_t   retransmits;
+    bool      used;
+} pending_t;
+
+static pending_t window[PROTOCOL_WINDOW_SIZE];
+
+/* CRC-8, polynomial 0x07 */
+static uint8_t crc8_update(uint8_t crc, uint8_t byte) {
+    crc ^= byte;
+    for (int i = 0; i < 8; i++) {
+        crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : (crc << 1);
+    }
+    return crc;
+}
+
+static uint8_t crc8(uint8_t crc, const uint8_t *buf, int size) {
+    for (int i = 0; i < size; i++) crc = crc8_update(crc, buf[i]);
+    return crc;
+}
+#endif
+
 void proto_init(protocol_t *proto, void (*callback)(const message_t *)) {
     proto->previous_id = 0;
     proto->callback   = callback;
     proto->state      = STATE_SYNC_1;
     proto->errors     = 0;
+#ifdef PROTOCOL_ACK_ENABLE
+    memset(proto->recent_ids, 0, sizeof(proto->recent_ids));
+    proto->recent_pos = 0;
+    memset(window, 0, sizeof(window));
+#endif
+}
+
+static void proto_write(uint8_t cmd, uint8_t id, const unsigned char *buf, int payload_size) {
+    const uint8_t header[PROTOCOL_HEADER_SIZE] = {
+        0x7A, 0x1D, cmd, id, payload_size,
+    };
+
+    sdWrite(&PROTOCOL_SD, header, sizeof(header));
+    if (payload_size) sdWrite(&PROTOCOL_SD, buf, payload_size);
+#ifdef PROTOCOL_ACK_ENABLE
+    const uint8_t crc = crc8(crc8(0, header + 2, sizeof(header) - 2), buf, payload_size);
+    sdPut(&PROTOCOL_SD, crc);
+#endif
 }
 
 static uint8_t msg_id = 0;
-void           proto_tx(uint8_t cmd, const unsigned char *buf, int payload_size, int retries) {
+
+#ifdef PROTOCOL_ACK_ENABLE
+static pending_t *window_find(uint8_t id) {
+    for (int i = 0; i < PROTOCOL_WINDOW_SIZE; i++) {
+        if (window[i].used && window[i].msg.msg_id == id) return &window[i];
+    }
+    return NULL;
+}
+
+static pending_t *window_free_slot(void) {
+    for (int i = 0; i < PROTOCOL_WINDOW_SIZE; i++) {
+        if (!window[i].used) return &window[i];
+    }
+    return NULL;
+}
+
+static void retransmit(pending_t *p) {
+    if (p->retransmits >= PROTOCOL_MAX_RETRANSMITS) {
+        /* Give up, the other side is probably gone */
+        p->used = false;
+        proto.errors++;
+        return;
+    }
+    p->retransmits++;
+    p->sent_at = chVTGetSystemTimeX();
+    proto_write(p->msg.command, p->msg.msg_id, p->msg.payload, p->msg.payload_size);
+}
+
+void proto_tx(uint8_t cmd, const unsigned char *buf, int payload_size, int retries) {
     chDbgCheck(payload_size <= MAX_PAYLOAD_SIZE);
+    (void)retries;
 
-    const uint8_t header[5] = {
-        0x7A, 0x1D, cmd, ++msg_id, payload_size,
-    };
+    pending_t *slot;
+    while ((slot = window_free_slot()) == NULL) {
+        /* Window full - wait for ACKs or timeouts to free a slot */
+        proto_task(&proto);
+    }
+
+    /* 0 is never used as an ID, so a fresh receiver can't mistake it for a duplicate */
+    if (++msg_id == 0) msg_id = 1;
+
+    slot->msg.command      = cmd;
+    slot->msg.msg_id       = msg_id;
+    slot->msg.payload_size = payload_size;
+    if (payload_size) memcpy(slot->msg.payload, buf, payload_size);
+    slot->retransmits = 0;
+    slot->sent_at     = chVTGetSystemTimeX();
+    slot->used        = true;
+
+    proto_write(cmd, msg_id, buf, payload_size);
+}
+#else
+void proto_tx(uint8_t cmd, const unsigned char *buf, int payload_size, int retries) {
+    chDbgCheck(payload_size <= MAX_PAYLOAD_SIZE);
+
+    ++msg_id;
 
     /* We don't implement ACKs, yet some messages should not be lost. */
     for (int i = 0; i < retries; i++) {
-        sdWrite(&PROTOCOL_SD, header, sizeof(header));
-        if (payload_size) sdWrite(&PROTOCOL_SD, buf, payload_size);
+        proto_write(cmd, msg_id, buf, payload_size);
     }
 }
+#endif
+
+size_t proto_tx_free(void) {
+    osalSysLock();
+    size_t free = oqGetEmptyI(&PROTOCOL_SD.oqueue);
+    osalSysUnlock();
+    return free;
+}
 
+uint8_t proto_tx_slots(void) {
+#ifdef PROTOCOL_ACK_ENABLE
+    uint8_t slots = 0;
+    for (int i = 0; i < PROTOCOL_WINDOW_SIZE; i++) {
+        if (!window[i].used) slots++;
+    }
+    return slots;
+#else
+    return UINT8_MAX;
+#endif
+}
+
+#ifdef PROTOCOL_ACK_ENABLE
+static bool is_duplicate(protocol_t *proto, uint8_t id) {
+    for (int i = 0; i < PROTOCOL_RECENT_IDS; i++) {
+        if (proto->recent_ids[i] == id) return true;
+    }
+    proto->recent_ids[proto->recent_pos] = id;
+    proto->recent_pos                    = (proto->recent_pos + 1) % PROTOCOL_RECENT_IDS;
+    return false;
+}
+
+static inline void messageReceived(protocol_t *proto) {
+    proto->state = STATE_SYNC_1;
+
+    if (proto->checksum != proto->buffer.checksum) {
+        proto->errors++;
+        if (proto->buffer.command != CMD_ACK && proto->buffer.command != CMD_NACK) {
+            proto_write(CMD_NACK, 0, &proto->buffer.msg_id, 1);
+        }
+        return;
+    }
+
+    switch (proto->buffer.command) {
+        case CMD_ACK: {
+            pending_t *p = window_find(proto->buffer.payload[0]);
+            if (p) p->used = false;
+            return;
+        }
+        case CMD_NACK: {
+            pending_t *p = window_find(proto->buffer.payload[0]);
+            if (p) retransmit(p);
+            return;
+        }
+    }
+
+    /* Always ACK, our previous ACK might have been the one that got lost */
+    proto_write(CMD_ACK, 0, &proto->buffer.msg_id, 1);
+
+    if (!is_duplicate(proto, proto->buffer.msg_id)) {
+        proto->callback(&proto->buffer);
+        proto->previous_id = proto->buffer.msg_id;
+    }
+}
+#else
 static inline void messageReceived(protocol_t *proto) {
     if (proto->buffer.msg_id != proto->previous_id) {
         /* It's not a resend / duplicate */
@@ -50,6 +212,16 @@ static inline void messageReceived(protocol_t *proto) {
     }
     proto->state = STATE_SYNC_1;
 }
+#endif
+
+/* Whole message body read; wait for the checksum if there is one */
+static inline void bodyReceived(protocol_t *proto) {
+#ifdef PROTOCOL_ACK_ENABLE
+    proto->state = STATE_CHECKSUM;
+#else
+    messageReceived(proto);
+#endif
+}
 
 void proto_consume(protocol_t *proto, uint8_t byte) {
     switch (proto->state) {
@@ -73,15 +245,24 @@ void proto_consume(protocol_t *proto, uint8_t byte) {
         case STATE_CMD:
             proto->buffer.command = byte;
             proto->state          = STATE_ID;
+#ifdef PROTOCOL_ACK_ENABLE
+            proto->checksum = crc8_update(0, byte);
+#endif
             return;
 
         case STATE_ID:
             proto->buffer.msg_id = byte;
             proto->state        = STATE_PAYLOAD_SIZE;
+#ifdef PROTOCOL_ACK_ENABLE
+            proto->checksum = crc8_update(proto->checksum, byte);
+#endif
             return;
 
         case STATE_PAYLOAD_SIZE:
             proto->buffer.payload_size = byte;
+#ifdef PROTOCOL_ACK_ENABLE
+            proto->checksum = crc8_update(proto->checksum, byte);
+#endif
             if (proto->buffer.payload_size > MAX_PAYLOAD_SIZE) {
                 proto->buffer.payload_size = MAX_PAYLOAD_SIZE;
                 proto->errors++;
@@ -89,7 +270,7 @@ void proto_consume(protocol_t *proto, uint8_t byte) {
             proto->payload_position = 0;
             if (proto->buffer.payload_size == 0) {
                 /* No payload - whole message received */
-                messageReceived(proto);
+                bodyReceived(proto);
             } else {
                 proto->state = STATE_PAYLOAD;
             }
@@ -100,11 +281,21 @@ void proto_consume(protocol_t *proto, uint8_t byte) {
              * abstraction */
             proto->buffer.payload[proto->payload_position] = byte;
             proto->payload_position++;
+#ifdef PROTOCOL_ACK_ENABLE
+            proto->checksum = crc8_update(proto->checksum, byte);
+#endif
             if (proto->payload_position == proto->buffer.payload_size) {
                 /* Payload read - message received */
-                messageReceived(proto);
+                bodyReceived(proto);
             }
             return;
+
+#ifdef PROTOCOL_ACK_ENABLE
+        case STATE_CHECKSUM:
+            proto->buffer.checksum = byte;
+            messageReceived(proto);
+            return;
+#endif
     }
 }
 
@@ -114,3 +305,18 @@ void proto_silence(protocol_t *proto) {
         proto->errors++;
     }
 }
+
+void proto_task(protocol_t *proto) {
+    /* While there's data from the other MCU - read it. */
+    while (!sdGetWouldBlock(&PROTOCOL_SD)) {
+        proto_consume(proto, sdGet(&PROTOCOL_SD));
+    }
+
+#ifdef PROTOCOL_ACK_ENABLE
+    for (int i = 0; i < PROTOCOL_WINDOW_SIZE; i++) {
+        if (window[i].used && chVTTimeElapsedSinceX(window[i].sent_at) >= TIME_MS2I(PROTOCOL_ACK_TIMEOUT)) {
+            retransmit(&window[i]);
+        }
+    }
+#endif
+}
@@ -8,6 +8,7 @@
 
 #pragma once
 #include <stdint.h>
+#include <stddef.h>
 
 #define PROTOCOL_SD SD0
 
@@ -63,8 +64,39 @@ enum {
     CMD_LED_STICKY_UNSET_KEY = 0x53,
     CMD_LED_STICKY_UNSET_ROW = 0x54,
     CMD_LED_STICKY_UNSET_ALL = 0x55,
+
+    /* Both directions, PROTOCOL_ACK_ENABLE only; payload is the msg_id */
+    CMD_ACK  = 0x60,
+    CMD_NACK = 0x61,
 };
 
+/* Size of the message header: 2 sync bytes, command, ID and payload size */
+#define PROTOCOL_HEADER_SIZE 5
+
+/* On-wire size of a message, including the trailing CRC-8 when acknowledged */
+#ifdef PROTOCOL_ACK_ENABLE
+#    define PROTOCOL_MSG_SIZE(payload_size) (PROTOCOL_HEADER_SIZE + (payload_size) + 1)
+#else
+#    define PROTOCOL_MSG_SIZE(payload_size) (PROTOCOL_HEADER_SIZE + (payload_size))
+#endif
+
+#ifdef PROTOCOL_ACK_ENABLE
+/* Number of unacknowledged messages allowed in flight */
+#    ifndef PROTOCOL_WINDOW_SIZE
+#        define PROTOCOL_WINDOW_SIZE 4
+#    endif
+/* Time to wait for an ACK before retransmitting, in ms */
+#    ifndef PROTOCOL_ACK_TIMEOUT
+#        define PROTOCOL_ACK_TIMEOUT 20
+#    endif
+/* Retransmissions of a single message before it is dropped */
+#    ifndef PROTOCOL_MAX_RETRANSMITS
+#        define PROTOCOL_MAX_RETRANSMITS 5
+#    endif
+/* Received IDs remembered for duplicate detection */
+#    define PROTOCOL_RECENT_IDS (PROTOCOL_WINDOW_SIZE * 2)
+#endif
+
 /* 1 ROW * 14 COLS * 4B (RGBX) = 56 + header prefix. */
 #define MAX_PAYLOAD_SIZE 64
 
@@ -81,6 +113,8 @@ enum proto_state {
     STATE_PAYLOAD_SIZE,
     /* Reading payload until payload_position == payload_size */
     STATE_PAYLOAD,
+    /* Waiting for the trailing CRC-8 (PROTOCOL_ACK_ENABLE only) */
+    STATE_CHECKSUM,
 };
 
 /* Buffer holding a single message */
@@ -89,6 +123,9 @@ typedef struct {
     uint8_t msg_id;
     uint8_t payload_size;
     uint8_t payload[MAX_PAYLOAD_SIZE];
+#ifdef PROTOCOL_ACK_ENABLE
+    uint8_t checksum;
+#endif
 } message_t;
 
 /* Internal protocol state */
@@ -105,6 +142,14 @@ typedef struct {
     uint8_t previous_id;
     uint8_t errors;
 
+#ifdef PROTOCOL_ACK_ENABLE
+    /* CRC-8 of the message read so far */
+    uint8_t checksum;
+    /* Recently delivered IDs, retransmits of these are dropped */
+    uint8_t recent_ids[PROTOCOL_RECENT_IDS];
+    uint8_t recent_pos;
+#endif
+
     /* Currently received message */
     message_t buffer;
 } protocol_t;
@@ -121,5 +166,14 @@ extern void proto_consume(protocol_t *proto, uint8_t byte);
 /* Prolonged silence - reset state */
 extern void proto_silence(protocol_t *proto);
 
+/* Read incoming bytes and retransmit unacknowledged messages */
+extern void proto_task(protocol_t *proto);
+
 /* Transmit message */
 extern void proto_tx(uint8_t cmd, const unsigned char *buf, int payload_size, int retries);
+
+/* Number of bytes that can be queued for transmission without blocking */
+extern size_t proto_tx_free(void);
+
+/* Number of messages that can be sent before proto_tx() waits for an ACK */
+extern uint8_t proto_tx_slots(void);
@@ -16,11 +16,29 @@
 
 #ifdef RGB_MATRIX_ENABLE
 
+#    include <string.h>
 #    include "rgb_matrix.h"
+#    include "timer.h"
 #    include "ap2_led.h"
 
+/* On-wire sizes of the color commands */
+#    define LED_KEY_MSG_SIZE PROTOCOL_MSG_SIZE(6)
+#    define LED_ROW_MSG_SIZE PROTOCOL_MSG_SIZE(1 + NUM_COLUMN * sizeof(ap2_led_t))
+#    define LED_MONO_MSG_SIZE PROTOCOL_MSG_SIZE(sizeof(ap2_led_t))
+
+/* Messages can get dropped on the UART; periodically push the whole frame again */
+#    ifndef AP2_LED_RESYNC_INTERVAL
+#        define AP2_LED_RESYNC_INTERVAL 1000
+#    endif
+
 uint8_t led_pos[RGB_MATRIX_LED_COUNT];
 
+/* Last colors pushed to the shine, used to only send what changed */
+static ap2_led_t led_colors_sent[KEY_COUNT];
+/* Rows whose entry in led_colors_sent matches what the shine shows */
+static uint8_t   led_rows_valid   = 0;
+static uint16_t  led_resync_timer = 0;
+
 void init(void) {
     unsigned int i = 0;
     for (unsigned int y = 0; y < NUM_ROW; y++) {
@@ -33,9 +51,79 @@ void init(void) {
     }
 }
 
+static uint16_t row_dirty_mask(uint8_t row) {
+    uint16_t mask = 0;
+    for (uint8_t col = 0; col < NUM_COLUMN; col++) {
+        uint8_t idx = ROWCOL2IDX(row, col);
+        if (!(led_rows_valid & (1 << row)) || led_colors[idx].rgb != led_colors_sent[idx].rgb) {
+            mask |= (1 << col);
+        }
+    }
+    return mask;
+}
+
+/* True if `messages` messages of `bytes` in total can be sent without waiting */
+static bool tx_room(uint8_t messages, size_t bytes) { return proto_tx_slots() >= messages && proto_tx_free() >= bytes; }
+
+/* True if every LED shows the same color, which can be sent as one mono command */
+static bool colors_are_mono(void) {
+    const uint32_t rgb = led_colors[led_pos[0]].rgb;
+    for (int i = 1; i < RGB_MATRIX_LED_COUNT; i++) {
+        if (led_colors[led_pos[i]].rgb != rgb) return false;
+    }
+    return true;
+}
+
+/*
+ * Only push what changed since the previous flush, using the cheapest command
+ * for each row. If the UART queue can't take a message without blocking, the
+ * remaining rows stay dirty and are sent on a later flush.
+ */
 void flush(void) {
-    for (uint8_t row = 0; row < NUM_ROW; row++)
-        ap2_led_colors_set_row(row);
+    uint16_t dirty[NUM_ROW];
+    bool     any_dirty = false;
+
+    /* Rows are resent one by one as the UART queue allows */
+    if (timer_elapsed(led_resync_timer) > AP2_LED_RESYNC_INTERVAL) {
+        led_rows_valid   = 0;
+        led_resync_timer = timer_read();
+    }
+
+    for (uint8_t row = 0; row < NUM_ROW; row++) {
+        dirty[row] = row_dirty_mask(row);
+        if (dirty[row]) any_dirty = true;
+    }
+    if (!any_dirty) return;
+
+    if (colors_are_mono()) {
+        const ap2_led_t color = led_colors[led_pos[0]];
+        if (!tx_room(1, LED_MONO_MSG_SIZE)) return;
+        ap2_led_colors_set_mono(color);
+        /* Matrix slots without an LED keep their color, they are never shown */
+        for (int i = 0; i < RGB_MATRIX_LED_COUNT; i++) led_colors_sent[led_pos[i]] = color;
+        led_rows_valid = (1 << NUM_ROW) - 1;
+        return;
+    }
+
+    for (uint8_t row = 0; row < NUM_ROW; row++) {
+        if (!dirty[row]) continue;
+
+        /* Per-key messages when they are cheaper and the ACK window has a
+         * slot for each, otherwise the row as one message */
+        const uint8_t changed = __builtin_popcount(dirty[row]);
+        if (changed * LED_KEY_MSG_SIZE < LED_ROW_MSG_SIZE && tx_room(changed, changed * LED_KEY_MSG_SIZE)) {
+            for (uint8_t col = 0; col < NUM_COLUMN; col++) {
+                if (dirty[row] & (1 << col)) {
+                    ap2_led_colors_set_key(row, col, led_colors[ROWCOL2IDX(row, col)]);
+                }
+            }
+        } else {
+            if (!tx_room(1, LED_ROW_MSG_SIZE)) return;
+            ap2_led_colors_set_row(row);
+        }
+        memcpy(&led_colors_sent[ROWCOL2IDX(row, 0)], &led_colors[ROWCOL2IDX(row, 0)], sizeof(*led_colors) * NUM_COLUMN);
+        led_rows_valid |= 1 << row;
+    }
 }
 
 void set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
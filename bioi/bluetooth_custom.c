@@ -12,34 +12,93 @@ You should have received a copy of the GNU General Public License
 along with this program. If not, see <http://www.gnu.org/licenses/>.
 */
 
+/*
+Reports are queued and written to the module from bluetooth_task(), only as
+fast as the wire drains the UART transmit buffer, so sending a report never
+waits on the UART. Keyboard and consumer reports that repeat the last one are
+dropped, and queued mouse reports with the same buttons are merged by adding
+up the motion.
+
+By default reports are sent as AT commands. Modules running the EZ-Key
+compatible firmware take binary reports instead, which are about a fifth of
+the size: define BLUEFRUIT_RAW_REPORTS in config.h to use them.
+*/
+
+#include <string.h>
 #include "bluetooth.h"
 #include "uart.h"
 #include "progmem.h"
-#include "wait.h"
+#include "timer.h"
 #include "debug.h"
 #include "usb_descriptor.h"
 #include "report.h"
 
-void send_str(const char *str)
+#ifndef BLUEFRUIT_BAUD
+#    define BLUEFRUIT_BAUD 76800
+#endif
+
+// Size of the UART driver's transmit ring
+#ifndef BLUEFRUIT_TX_BUFFER
+#    define BLUEFRUIT_TX_BUFFER 64
+#endif
+
+#ifndef BLUEFRUIT_QUEUE_SIZE
+#    define BLUEFRUIT_QUEUE_SIZE 8
+#endif
+
+// Time the module needs after power up before it takes commands
+#ifndef BLUEFRUIT_INIT_DELAY
+#    define BLUEFRUIT_INIT_DELAY 250
+#endif
+
+// 10 bits per byte on the wire
+#define BLUEFRUIT_BYTES_PER_MS (BLUEFRUIT_BAUD / 10000)
+
+enum bluefruit_report_type {
+    REPORT_KEYBOARD,
+    REPORT_MOUSE,
+    REPORT_CONSUMER,
+};
+
+typedef struct {
+    uint8_t type;
+    uint8_t data[8];
+} bluefruit_report_t;
+
+static bluefruit_report_t queue[BLUEFRUIT_QUEUE_SIZE];
+static uint8_t            queue_head, queue_count;
+
+// Newest keyboard and consumer report, queued or sent
+static uint8_t latest[REPORT_CONSUMER + 1][8];
+
+static bool     ready;
+static uint16_t init_time;
+
+// Bytes estimated to be waiting in the UART transmit ring
+static uint16_t tx_backlog;
+static uint16_t tx_time;
+
+static void bluefruit_write(uint8_t data)
 {
-    uint8_t c;
-    while ((c = pgm_read_byte(str++)))
-        uart_write(c);
+#ifdef BLUEFRUIT_TRACE_SERIAL
+    dprintf(" %02X ", data);
+#endif
+    tx_backlog++;
+    uart_write(data);
 }
 
-void serial_send(uint8_t data)
+static void send_str(const char *str)
 {
-    dprintf("Sending: %u\n", data);
+    uint8_t c;
+    while ((c = pgm_read_byte(str++)))
+        bluefruit_write(c);
 }
 
-void send_bytes(uint8_t data)
+static void send_bytes(uint8_t data)
 {
-    char hexStr[3];
-    sprintf(hexStr, "%02X", data);
-    for (int j = 0; j < sizeof(hexStr) - 1; j++)
-    {
-        uart_write(hexStr[j]);
-    }
+    static const char hex[] = "0123456789ABCDEF";
+    bluefruit_write(hex[data >> 4]);
+    bluefruit_write(hex[data & 0x0F]);
 }
 
 #ifdef BLUEFRUIT_TRACE_SERIAL
@@ -56,64 +115,154 @@ static void bluefruit_trace_footer(void)
 }
 #endif
 
-static void bluefruit_serial_send(uint8_t data)
+// Bytes a report takes on the wire
+static uint8_t report_size(const bluefruit_report_t *report)
+{
+#ifdef BLUEFRUIT_RAW_REPORTS
+    return 9;
+#else
+    // AT+BLEKEYBOARDCODE=MM-00-K1-K2-K3-K4-K5-K6\r\n and
+    // AT+BLEHIDCONTROLKEY=0xUUUU\r\n
+    return report->type == REPORT_KEYBOARD ? 44 : 28;
+#endif
+}
+
+static void write_report(const bluefruit_report_t *report)
 {
 #ifdef BLUEFRUIT_TRACE_SERIAL
-    dprintf(" %02X ", data);
+    bluefruit_trace_header();
+#endif
+#ifdef BLUEFRUIT_RAW_REPORTS
+    // 0xFD, then the keyboard report, or 0x00, a type and the report
+    bluefruit_write(0xFD);
+    for (uint8_t i = 0; i < sizeof(report->data); i++) {
+        bluefruit_write(report->data[i]);
+    }
+#else
+    if (report->type == REPORT_KEYBOARD) {
+        send_str(PSTR("AT+BLEKEYBOARDCODE="));
+        for (uint8_t i = 0; i < sizeof(report->data); i++) {
+            if (i) send_str(PSTR("-"));
+            send_bytes(report->data[i]);
+        }
+    } else {
+        send_str(PSTR("AT+BLEHIDCONTROLKEY=0x"));
+        send_bytes(report->data[0]);
+        send_bytes(report->data[1]);
+    }
+    send_str(PSTR("\r\n"));
+#endif
+#ifdef BLUEFRUIT_TRACE_SERIAL
+    bluefruit_trace_footer();
 #endif
-    serial_send(data);
 }
 
-void bluetooth_init(void) {
-    uart_init(76800);
-    wait_ms(250);
+static void update_backlog(void)
+{
+    uint16_t elapsed = timer_elapsed(tx_time);
+    if (elapsed == 0) return;
 
-    send_str(PSTR("\r\n"));
-    send_str(PSTR("\r\n"));
-    send_str(PSTR("\r\n"));
+    uint32_t drained = (uint32_t)elapsed * BLUEFRUIT_BYTES_PER_MS;
+    tx_backlog = drained >= tx_backlog ? 0 : tx_backlog - drained;
+    tx_time += elapsed;
 }
 
-void bluetooth_task(void) {}
+// Write queued reports while they fit in the transmit ring
+static void send_queue(void)
+{
+    if (!ready) return;
+
+    update_backlog();
+    while (queue_count) {
+        bluefruit_report_t *report = &queue[queue_head];
+        if (tx_backlog + report_size(report) > BLUEFRUIT_TX_BUFFER) break;
 
-void bluetooth_send_keyboard(report_keyboard_t *report)
+        write_report(report);
+        queue_head = (queue_head + 1) % BLUEFRUIT_QUEUE_SIZE;
+        queue_count--;
+    }
+}
+
+static void queue_report(uint8_t type, const uint8_t *data)
 {
-#ifdef BLUEFRUIT_TRACE_SERIAL
-    bluefruit_trace_header();
-#endif
-    dprintf("Sending...\n");
+    // Keyboard and consumer reports are state, a repeat changes nothing
+    if (type != REPORT_MOUSE) {
+        if (!memcmp(latest[type], data, sizeof(latest[type]))) return;
+        memcpy(latest[type], data, sizeof(latest[type]));
+    }
+
+    if (queue_count == BLUEFRUIT_QUEUE_SIZE) {
+        // Out of room, so this one has to wait on the UART
+        dprintf("Bluefruit queue full\n");
+        if (ready) {
+            write_report(&queue[queue_head]);
+        }
+        queue_head = (queue_head + 1) % BLUEFRUIT_QUEUE_SIZE;
+        queue_count--;
+    }
 
-    send_str(PSTR("AT+BLEKEYBOARDCODE="));
+    bluefruit_report_t *report = &queue[(queue_head + queue_count) % BLUEFRUIT_QUEUE_SIZE];
+    report->type = type;
+    memcpy(report->data, data, sizeof(report->data));
+    queue_count++;
 
-    send_bytes(report->mods);
-    send_str(PSTR("-"));
-    send_bytes(0);
-    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
-        send_str(PSTR("-"));
-        send_bytes(report->keys[i]);
+    send_queue();
+}
+
+void bluetooth_init(void) {
+    uart_init(BLUEFRUIT_BAUD);
+    init_time = timer_read();
+}
+
+void bluetooth_task(void) {
+    if (!ready) {
+        if (timer_elapsed(init_time) < BLUEFRUIT_INIT_DELAY) return;
+
+        ready   = true;
+        tx_time = timer_read();
+        send_str(PSTR("\r\n"));
+        send_str(PSTR("\r\n"));
+        send_str(PSTR("\r\n"));
     }
 
-    send_str(PSTR("\r\n"));
-#ifdef BLUEFRUIT_TRACE_SERIAL
-    bluefruit_trace_footer();
-#endif
+    send_queue();
+}
+
+void bluetooth_send_keyboard(report_keyboard_t *report)
+{
+    uint8_t data[8] = {report->mods, 0};
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS && i < 6; i++) {
+        data[2 + i] = report->keys[i];
+    }
+    queue_report(REPORT_KEYBOARD, data);
 }
 
 void bluetooth_send_mouse(report_mouse_t *report)
 {
-#ifdef BLUEFRUIT_TRACE_SERIAL
-    bluefruit_trace_header();
-#endif
-    bluefruit_serial_send(0xFD);
-    bluefruit_serial_send(0x00);
-    bluefruit_serial_send(0x03);
-    bluefruit_serial_send(report->buttons);
-    bluefruit_serial_send(report->x);
-    bluefruit_serial_send(report->y);
-    bluefruit_serial_send(report->v); // should try sending the wheel v here
-    bluefruit_serial_send(report->h); // should try sending the wheel h here
-    bluefruit_serial_send(0x00);
-#ifdef BLUEFRUIT_TRACE_SERIAL
-    bluefruit_trace_footer();
+#ifdef BLUEFRUIT_RAW_REPORTS
+    // Motion with the same buttons adds up while it waits
+    if (queue_count) {
+        bluefruit_report_t *last = &queue[(queue_head + queue_count - 1) % BLUEFRUIT_QUEUE_SIZE];
+        if (last->type == REPORT_MOUSE && last->data[2] == report->buttons) {
+            int16_t x = (int8_t)last->data[3] + report->x;
+            int16_t y = (int8_t)last->data[4] + report->y;
+            int16_t v = (int8_t)last->data[5] + report->v;
+            int16_t h = (int8_t)last->data[6] + report->h;
+            if (x >= -127 && x <= 127 && y >= -127 && y <= 127 && v >= -127 && v <= 127 && h >= -127 && h <= 127) {
+                last->data[3] = x;
+                last->data[4] = y;
+                last->data[5] = v;
+                last->data[6] = h;
+                return;
+            }
+        }
+    }
+
+    uint8_t data[8] = {0x00, 0x03, report->buttons, report->x, report->y, report->v, report->h, 0x00};
+    queue_report(REPORT_MOUSE, data);
+#else
+    // No mouse over AT commands
+    dprintf("Bluefruit mouse report dropped\n");
 #endif
 }
 
@@ -136,22 +285,25 @@ void bluetooth_send_mouse(report_mouse_t *report)
 | Stop            | 00000000 00010000 | 00 10 |
 +-------------------------------------+-------+
 */
+#define CONSUMER2EZKEY(usage) \
+    (usage == AC_HOME ? 0x0001 : (usage == AC_SEARCH ? 0x0004 : (usage == AUDIO_VOL_UP ? 0x0010 : (usage == AUDIO_VOL_DOWN ? 0x0020 : (usage == TRANSPORT_PLAY_PAUSE ? 0x0040 : (usage == TRANSPORT_FAST_FORWARD ? 0x0080 : (usage == TRANSPORT_REWIND ? 0x0100 : (usage == TRANSPORT_NEXT_TRACK ? 0x0200 : (usage == TRANSPORT_PREV_TRACK ? 0x0400 : (usage == TRANSPORT_STOP ? 0x1000 : 0))))))))))
+
+// Usage IDs for AT+BLEHIDCONTROLKEY
 #define CONSUMER2BLUEFRUIT(usage) \
     (usage == AUDIO_MUTE ? 0x00e2 : (usage == AUDIO_VOL_UP ? 0x00e9 : (usage == AUDIO_VOL_DOWN ? 0x00ea : (usage == TRANSPORT_NEXT_TRACK ? 0x00b5 : (usage == TRANSPORT_PREV_TRACK ? 0x00b6 : (usage == TRANSPORT_STOP ? 0x00b7 : (usage == TRANSPORT_STOP_EJECT ? 0x00b8 : (usage == TRANSPORT_PLAY_PAUSE ? 0x00b1 : (usage == AL_CC_CONFIG ? 0x0183 : (usage == AL_EMAIL ? 0x018c : (usage == AL_CALCULATOR ? 0x0192 : (usage == AL_LOCAL_BROWSER ? 0x0196 : (usage == AC_SEARCH ? 0x021f : (usage == AC_HOME ? 0x0223 : (usage == AC_BACK ? 0x0224 : (usage == AC_FORWARD ? 0x0225 : (usage == AC_STOP ? 0x0226 : (usage == AC_REFRESH ? 0x0227 : (usage == AC_BOOKMARKS ? 0x022a : 0)))))))))))))))))))
 
 void bluetooth_send_consumer(uint16_t usage)
 {
+#ifdef BLUEFRUIT_RAW_REPORTS
+    uint16_t bitmap = CONSUMER2EZKEY(usage);
+    uint8_t  data[8] = {0x00, 0x02, bitmap & 0xFF, (bitmap >> 8) & 0xFF};
+#else
     uint16_t bitmap = CONSUMER2BLUEFRUIT(usage);
-
-#ifdef BLUEFRUIT_TRACE_SERIAL
-    dprintf("\nData: %04X; bitmap: %04X\n", data, bitmap);
-    bluefruit_trace_header();
+    uint8_t  data[8] = {(bitmap >> 8) & 0xFF, bitmap & 0xFF};
 #endif
-    send_str(PSTR("AT+BLEHIDCONTROLKEY=0x"));
-    send_bytes((bitmap >> 8) & 0xFF);
-    send_bytes(bitmap & 0xFF);
-    send_str(PSTR("\r\n"));
+
 #ifdef BLUEFRUIT_TRACE_SERIAL
-    bluefruit_trace_footer();
+    dprintf("\nUsage: %04X; bitmap: %04X\n", usage, bitmap);
 #endif
+    queue_report(REPORT_CONSUMER, data);
 }
@@ -39,6 +39,7 @@ uint8_t enabled_encoder_modes = 0x1F;
 
 RTCDateTime last_timespec;
 uint16_t last_minute = 0;
+static uint32_t clock_refresh_timer = 0;
 
 uint8_t time_config_idx = 0;
 int8_t hour_config = 0;
@@ -205,6 +206,12 @@ void read_host_led_state(void) {
     }
 }
 
+bool led_update_kb(led_t led_state) {
+  bool res = led_update_user(led_state);
+  oled_request_repaint();
+  return res;
+}
+
 layer_state_t layer_state_set_kb(layer_state_t state) {
   state = layer_state_set_user(state);
   layer = get_highest_layer(state);
@@ -331,12 +338,24 @@ void matrix_init_kb(void)
 #endif // VIA_ENABLE
 
   rtcGetTime(&RTCD1, &last_timespec);
+  clock_request_refresh();
   matrix_init_user();
   oled_request_wakeup();
 }
 
 
+// Read the clock on the next housekeeping pass, e.g. after it was set.
+void clock_request_refresh(void) {
+  clock_refresh_timer = timer_read32();
+}
+
 void housekeeping_task_kb(void) {
+  // The OLED only shows minutes, so the RTC is only read when the next
+  // minute is due instead of on every pass.
+  if (!timer_expired32(timer_read32(), clock_refresh_timer)) {
+    return;
+  }
+
   rtcGetTime(&RTCD1, &last_timespec);
   uint16_t minutes_since_midnight = last_timespec.millisecond / 1000 / 60;
 
@@ -344,6 +363,8 @@ void housekeeping_task_kb(void) {
     last_minute = minutes_since_midnight;
     oled_request_repaint();
   }
+
+  clock_refresh_timer = timer_read32() + (60000 - last_timespec.millisecond % 60000);
 }
 
 //
@@ -88,6 +88,7 @@ uint16_t retrieve_custom_encoder_config(uint8_t encoder_idx, uint8_t behavior);
 void set_custom_encoder_config(uint8_t encoder_idx, uint8_t behavior, uint16_t new_code);
 
 void update_time_config(int8_t increment);
+void clock_request_refresh(void);
 
 void oled_request_wakeup(void);
 void oled_request_repaint(void);
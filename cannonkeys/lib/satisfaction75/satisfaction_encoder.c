@@ -17,6 +17,7 @@ void pre_encoder_mode_change(void){
     // timespec.dstflag = last_timespec.dstflag;
     timespec.millisecond = (hour_config * 60 + minute_config) * 60 * 1000;
     rtcSetTime(&RTCD1, &timespec);
+    clock_request_refresh();
   }
 }
 
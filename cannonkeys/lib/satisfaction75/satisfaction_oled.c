@@ -10,6 +10,7 @@
 #include "host.h"
 #include "oled_driver.h"
 #include "progmem.h"
+#include "util.h"
 #include <stdio.h>
 
 void draw_default(void);
@@ -97,24 +98,39 @@ bool oled_task_needs_to_repaint(void) {
         return false;
     }
 
-    // Always perform a repaint if the OLED is currently on.  (This can
-    // potentially be optimized to avoid unneeded repaints if all possible
-    // state changes are covered by oled_request_repaint() or
-    // oled_request_wakeup(), but then any missed calls to these functions
-    // would result in displaying a stale image.)
-    return true;
+    // Nothing changed since the last repaint.  Every state shown on the OLED
+    // has to call oled_request_repaint() or oled_request_wakeup() when it
+    // changes: layers, host LEDs, mods and the matrix (via process_record_kb),
+    // encoder mode and the clock.
+    return false;
 }
 
+// Set the bits in `mask` of the buffer byte at `index`, leaving the others
+// untouched.  One byte covers a column of 8 pixels within a page.
+static void oled_or_raw_byte(uint16_t index, uint8_t mask) {
+    oled_buffer_reader_t reader = oled_read_raw(index);
+    oled_write_raw_byte(*reader.current_element | mask, index);
+}
 
 static void draw_line_h(uint8_t x, uint8_t y, uint8_t len) {
+    uint16_t index = (y / 8) * OLED_DISPLAY_WIDTH + x;
+    uint8_t  mask  = 1 << (y % 8);
+
     for (uint8_t i = 0; i < len; i++) {
-        oled_write_pixel(i + x, y, true);
+        oled_or_raw_byte(index + i, mask);
     }
 }
 
 static void draw_line_v(uint8_t x, uint8_t y, uint8_t len) {
-    for (uint8_t i = 0; i < len; i++) {
-        oled_write_pixel(x, i + y, true);
+    // Fill one byte per page the line crosses
+    while (len > 0) {
+        uint8_t bit   = y % 8;
+        uint8_t count = MIN(len, 8 - bit);
+        uint8_t mask  = (uint8_t)(0xFF << bit) & (0xFF >> (8 - bit - count));
+
+        oled_or_raw_byte((y / 8) * OLED_DISPLAY_WIDTH + x, mask);
+        y += count;
+        len -= count;
     }
 }
 
@@ -52,35 +52,89 @@ uint16_t max7219_buffer_end = 0;
 uint8_t max7219_spidata[MAX_BYTES];
 uint8_t max7219_led_a[8][MAX7219_BUFFER_SIZE];
 
+/* The message is scrolled by moving max7219_scroll_offset through
+ * max7219_led_a as a ring instead of shifting the buffer itself.
+ */
+static uint16_t max7219_scroll_offset = 0;
+
+/* What the controllers are currently showing, used to only send digits that changed */
+static uint8_t max7219_shown[8][MAX7219_CONTROLLERS];
+static bool max7219_shown_valid = false;
+
+#ifdef MAX7219_SCROLL_TIMING
+/* Number of bytes sent over SPI, for measuring the cost of a frame */
+static uint16_t max7219_spi_bytes = 0;
+#endif
+
+/* Length of the ring max7219_led_a is scrolled through, in columns
+ */
+static uint16_t max7219_ring_len(void) {
+    if (max7219_buffer_end == 0 || max7219_buffer_end > MAX7219_BUFFER_SIZE * 8) {
+        return MAX7219_BUFFER_SIZE * 8;
+    }
+    return max7219_buffer_end;
+}
+
+/* Return the buffer cell that is shown in a given display column
+ */
+static uint8_t *max7219_column(uint16_t display_col) {
+    uint16_t i = (max7219_scroll_offset + display_col) % max7219_ring_len();
+    return &max7219_led_a[i % 8][i / 8];
+}
+
 /* Write max7219_spidata to all the max7219's
  */
 void max7219_write_all(void) {
-    dprintf("max7219_write_all()\n");
+    uint8_t data[MAX_BYTES];
+
+    // The last controller in the chain has to be shifted out first
+    for (int i = 0; i < MAX_BYTES; i++) {
+        data[i] = max7219_spidata[MAX_BYTES - 1 - i];
+    }
+
     if (spi_start(MAX7219_LOAD, false, 0, 8)) {
-        for(int i = MAX_BYTES; i>0; i--) {
-            dprintf("spi_write(%d)\n", max7219_spidata[i-1]);
-            spi_write(max7219_spidata[i-1]);
-        }
+        spi_transmit(data, MAX_BYTES);
         spi_stop();
+#ifdef MAX7219_SCROLL_TIMING
+        max7219_spi_bytes += MAX_BYTES;
+#endif
     } else {
         xprintf("Could not spi_start!\n");
     }
 }
 
-/* Write the current frame in max7219_led_a to all the max7219's
+/* Write the current frame in max7219_led_a to all the max7219's.
+ *
+ * Each MAX7219 latches one digit per load, so a frame takes up to 8
+ * transactions. Digits that didn't change since the last frame are
+ * skipped, and controllers whose digit didn't change get a no-op.
  */
 void max7219_write_frame(void) {
     dprintf("max7219_write_frame()\n");
 
-    // Set our opcode and data
     for (int col=0; col<8; col++) {
+        bool changed = false;
+
         for (int device_num=0; device_num<MAX7219_CONTROLLERS; device_num++) {
             int offset=device_num*2;
-            max7219_spidata[offset] = max7219_led_a[col][device_num];
-            max7219_spidata[offset+1] = col+1;
+            uint8_t data = *max7219_column(device_num*8 + col);
+
+            if (max7219_shown_valid && max7219_shown[col][device_num] == data) {
+                max7219_spidata[offset] = 0;
+                max7219_spidata[offset+1] = OP_NOOP;
+            } else {
+                max7219_spidata[offset] = data;
+                max7219_spidata[offset+1] = col+1;
+                max7219_shown[col][device_num] = data;
+                changed = true;
+            }
+        }
+
+        if (changed) {
+            max7219_write_all();
         }
-        max7219_write_all();
     }
+    max7219_shown_valid = true;
 }
 
 /* Stores a message in the sign buffer.
@@ -98,6 +152,7 @@ void max7219_message_sign(uint8_t message[][6], size_t message_len) {
     uint8_t letter_num = 0;
     uint8_t letter_col = 0;
     max7219_buffer_end = message_len * 6 + 32;
+    max7219_scroll_offset = 0;
 
     for (int device_num=0; device_num<MAX7219_BUFFER_SIZE; device_num++) {
         for (int col=0; col<8; col++) {
@@ -124,36 +179,23 @@ void max7219_message_sign(uint8_t message[][6], size_t message_len) {
  * to the right to be displayed again.
  */
 void max7219_message_sign_task(bool loop_message) {
-    uint8_t left_col = 0b00000000;
-
     if (!max7219_led_scrolling) {
         return;
     }
 
-    if (loop_message) {
-        left_col = max7219_led_a[0][0];
+    if (!loop_message) {
+        // The column sliding off the left comes back blank on the right
+        *max7219_column(0) = 0b00000000;
     }
+    max7219_scroll_offset = (max7219_scroll_offset + 1) % max7219_ring_len();
 
-    int i=0;
-
-    for (int device_num=0; device_num<MAX7219_BUFFER_SIZE; device_num++) {
-        for (int col=0; col<8; col++) {
-            i++;
-
-            if (i == max7219_buffer_end) {
-                max7219_led_a[col][device_num] = left_col;
-                device_num=MAX7219_BUFFER_SIZE;
-                break;
-            } else if (col < 7) {
-                max7219_led_a[col][device_num] = max7219_led_a[col+1][device_num];
-            } else if (device_num == MAX7219_BUFFER_SIZE-1) {
-                max7219_led_a[col][device_num] = left_col;
-            } else {
-                max7219_led_a[col][device_num] = max7219_led_a[0][device_num+1];
-            }
-        }
-    }
+#ifdef MAX7219_SCROLL_TIMING
+    max7219_spi_bytes = 0;
+#endif
     max7219_write_frame();
+#ifdef MAX7219_SCROLL_TIMING
+    dprintf("max7219: scroll step sent %u SPI bytes\n", max7219_spi_bytes);
+#endif
 }
 
 /* Write data to a single max7219
@@ -173,6 +215,11 @@ void max7219_write(int device_num, volatile uint8_t opcode, volatile uint8_t dat
 
     // Write the data
     max7219_write_all();
+
+    // Keep the shadow frame in sync with direct digit writes
+    if (opcode >= 1 && opcode <= 8) {
+        max7219_shown[opcode-1][device_num] = data;
+    }
 }
 
 /* Turn off all the LEDs
@@ -185,6 +232,7 @@ void max7219_clear_display(void) {
             max7219_led_a[col][device_num] = 0b00000000;
         }
     }
+    max7219_scroll_offset = 0;
     max7219_write_frame();
 }
 
@@ -285,14 +333,15 @@ void max7219_set_led(int row, int column, bool state) {
     uint8_t device_num = column / 8;
     uint8_t col = column % 8;
     uint8_t val = 0b10000000 >> row;
+    uint8_t *cell = max7219_column(column);
 
     if (state) {
-        max7219_led_a[col][device_num] = max7219_led_a[col][device_num]|val;
+        *cell = *cell|val;
     } else {
         val = ~val;
-        max7219_led_a[col][device_num] = max7219_led_a[col][device_num]&val;
+        *cell = *cell&val;
     }
-    max7219_write(device_num, col+1, max7219_led_a[col][device_num]);
+    max7219_write(device_num, col+1, *cell);
 }
 
 /* Set the number of digits (rows) to be scanned.
@@ -62,6 +62,7 @@
 #define MAX7219_BUFFER_SIZE MAX7219_CONTROLLERS*MAX7219_BUFFER_MULTIPLIER
 
 // Opcodes for the MAX7219
+#define OP_NOOP        0
 #define OP_DECODEMODE  9
 #define OP_INTENSITY   10
 #define OP_SCANLIMIT   11
@@ -32,6 +32,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 static void matrix_make(uint8_t code);
 static void matrix_break(uint8_t code);
+static void matrix_clear(void);
 
 
 /*
@@ -65,12 +66,128 @@ void matrix_init(void)
     ps2_host_init();
 
     // initialize matrix state: all keys off
-    for (uint8_t i=0; i < MATRIX_ROWS; i++) matrix[i] = 0x00;
+    matrix_clear();
 
     matrix_init_user();
     return;
 }
 
+/*
+ * Scan Code Set 3 decoder
+ *
+ * Every received byte is classified and looked up in set3_table with the
+ * current decoder state. With all keys in make/break mode the terminal only
+ * ever sends a make code, or F0 followed by the same code on release.
+ */
+enum set3_state {
+    SET3_MAKE,
+    SET3_BREAK,     // F0 received
+    SET3_STATES
+};
+
+enum set3_class {
+    SET3_KEY,       // 0x01-0x87
+    SET3_F0,        // break prefix
+    SET3_OVERRUN,   // 0xFF, the terminal's buffer overflowed
+    SET3_BAT,       // 0xAA, the terminal was plugged in again
+    SET3_ACK,       // 0xFA, late reply to a command
+    SET3_UNKNOWN,
+    SET3_CLASSES
+};
+
+enum set3_action {
+    SET3_NONE,
+    SET3_DO_MAKE,
+    SET3_DO_BREAK,
+    SET3_DO_ERROR,  // lost track of the stream, release everything
+    SET3_DO_RESET,  // configure the terminal again
+};
+
+static const struct {
+    uint8_t action;
+    uint8_t next;
+} set3_table[SET3_STATES][SET3_CLASSES] = {
+    [SET3_MAKE] = {
+        [SET3_KEY]      = { SET3_DO_MAKE,  SET3_MAKE  },
+        [SET3_F0]       = { SET3_NONE,     SET3_BREAK },
+        [SET3_OVERRUN]  = { SET3_DO_ERROR, SET3_MAKE  },
+        [SET3_BAT]      = { SET3_DO_RESET, SET3_MAKE  },
+        [SET3_ACK]      = { SET3_NONE,     SET3_MAKE  },
+        [SET3_UNKNOWN]  = { SET3_DO_ERROR, SET3_MAKE  },
+    },
+    [SET3_BREAK] = {
+        [SET3_KEY]      = { SET3_DO_BREAK, SET3_MAKE  },
+        [SET3_F0]       = { SET3_DO_ERROR, SET3_MAKE  },
+        [SET3_OVERRUN]  = { SET3_DO_ERROR, SET3_MAKE  },
+        [SET3_BAT]      = { SET3_DO_RESET, SET3_MAKE  },
+        [SET3_ACK]      = { SET3_DO_ERROR, SET3_MAKE  },
+        [SET3_UNKNOWN]  = { SET3_DO_ERROR, SET3_MAKE  },
+    },
+};
+
+static uint8_t set3_classify(uint8_t code)
+{
+    switch (code) {
+        case 0xFF: return SET3_OVERRUN;
+        case 0xF0: return SET3_F0;
+        case 0xAA: return SET3_BAT;
+        case 0xFA: return SET3_ACK;
+        default:   return (code < 0x88) ? SET3_KEY : SET3_UNKNOWN;
+    }
+}
+
+static void matrix_clear(void)
+{
+    for (uint8_t i=0; i < MATRIX_ROWS; i++) matrix[i] = 0x00;
+}
+
+// returns false when the terminal has to be configured again
+static bool set3_decode(uint8_t code)
+{
+    static uint8_t state = SET3_MAKE;
+    uint8_t class = set3_classify(code);
+    uint8_t action = set3_table[state][class].action;
+    state = set3_table[state][class].next;
+
+    switch (action) {
+        case SET3_DO_MAKE:
+            matrix_make(code);
+            break;
+        case SET3_DO_BREAK:
+            matrix_break(code);
+            break;
+        case SET3_DO_ERROR:
+            // a make or break went missing, so no key state can be trusted
+            dprintf("unexpected scan code: %02X\n", code);
+            matrix_clear();
+            break;
+        case SET3_DO_RESET:
+            dprint("terminal reset\n");
+            matrix_clear();
+            return false;
+    }
+    return true;
+}
+
+/* true when a byte was received, the driver returns 0 when its buffer is empty */
+static bool recv_code(uint8_t *code)
+{
+    *code = ps2_host_recv();
+    return *code != 0;
+}
+
+/* send a command, repeating it while the terminal asks for a resend */
+static bool send_command(uint8_t command)
+{
+    for (uint8_t retry = 0; retry < 3; retry++) {
+        uint8_t res = ps2_host_send(command);
+        if (res == 0xFA) return true;
+        if (res != 0xFE) break;
+        dprintf("w%02X resend\n", command);
+    }
+    return false;
+}
+
 uint8_t matrix_scan(void)
 {
 
@@ -82,82 +199,60 @@ uint8_t matrix_scan(void)
         KBD_ID1,
         CONFIG,
         READY,
-        F0_BREAK,
     } state = RESET;
 
-    uint8_t code;
-    if ((code = ps2_host_recv())) {
-        dprintf("r%02X ", code);
-    }
-
     switch (state) {
         case RESET:
             dprint("wFF ");
-            if (ps2_host_send(0xFF) == 0xFA) {
+            if (send_command(0xFF)) {
                 dprint("[ack]\nRESET_RESPONSE: ");
                 state = RESET_RESPONSE;
             }
-            break;
-        case RESET_RESPONSE:
-            if (code == 0xAA) {
-                dprint("[ok]\nKBD_ID: ");
-                state = KBD_ID0;
-            } else if (code) {
-                dprint("err\nRESET: ");
-                state = RESET;
-            }
-            break;
-        // after reset receive keyboard ID(2 bytes)
-        case KBD_ID0:
-            if (code) {
-                state = KBD_ID1;
-            }
-            break;
-        case KBD_ID1:
-            if (code) {
-                dprint("\nCONFIG: ");
-                state = CONFIG;
-            }
-            break;
+            return 1;
         case CONFIG:
+            // all keys make/break: no typematic repeat and a break code for
+            // every key, the host does the repeating
             dprint("wF8 ");
-            if (ps2_host_send(0xF8) == 0xFA) {
+            if (send_command(0xF8)) {
                 dprint("[ack]\nREADY\n");
                 state = READY;
             }
+            return 1;
+        default:
             break;
-        case READY:
-            switch (code) {
-                case 0x00:
-                    break;
-                case 0xF0:
-                    state = F0_BREAK;
-                    dprint(" ");
-                    break;
-                default:    // normal key make
-                    if (code < 0x88) {
-                        matrix_make(code);
-                    } else {
-                        dprintf("unexpected scan code at READY: %02X\n", code);
-                    }
-                    state = READY;
-                    dprint("\n");
-            }
-            break;
-        case F0_BREAK:    // Break code
-            switch (code) {
-                case 0x00:
-                    break;
-                default:
-                    if (code < 0x88) {
-                        matrix_break(code);
-                    } else {
-                        dprintf("unexpected scan code at F0: %02X\n", code);
-                    }
-                    state = READY;
-                    dprint("\n");
-            }
-            break;
+    }
+
+    // drain everything the PS/2 interrupt has buffered since the last scan
+    uint8_t code;
+    while (state != RESET && state != CONFIG && recv_code(&code)) {
+        dprintf("r%02X ", code);
+
+        switch (state) {
+            case RESET_RESPONSE:
+                if (code == 0xAA) {
+                    dprint("[ok]\nKBD_ID: ");
+                    state = KBD_ID0;
+                } else {
+                    dprint("err\nRESET: ");
+                    state = RESET;
+                }
+                break;
+            // after reset receive keyboard ID(2 bytes)
+            case KBD_ID0:
+                state = KBD_ID1;
+                break;
+            case KBD_ID1:
+                dprint("\nCONFIG: ");
+                state = CONFIG;
+                break;
+            case READY:
+                if (!set3_decode(code)) {
+                    state = RESET;
+                }
+                break;
+            default:
+                break;
+        }
     }
     return 1;
 }
@@ -36,8 +36,41 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define SLAVE_I2C_ADDRESS_NUMPAD 0x36
 #define SLAVE_I2C_ADDRESS_ARROW 0x40
 
+#define SLAVE_I2C_MARKER 0x55
+
 #define ERROR_DISCONNECT_COUNT 5
 
+#ifndef MODULE_I2C_TIMEOUT
+#    define MODULE_I2C_TIMEOUT 5
+#endif
+
+/* Missing modules are probed at an interval that doubles on every failed
+ * probe, from MODULE_PROBE_INTERVAL_MIN up to MODULE_PROBE_INTERVAL_MAX ms */
+#ifndef MODULE_PROBE_INTERVAL_MIN
+#    define MODULE_PROBE_INTERVAL_MIN 16
+#endif
+#ifndef MODULE_PROBE_INTERVAL_MAX
+#    define MODULE_PROBE_INTERVAL_MAX 1024
+#endif
+
+#define LOCAL_COLS_MASK ((((matrix_row_t)1) << MATRIX_COLS_SCANNED) - 1)
+
+typedef struct {
+    uint8_t  address;
+    uint8_t  col_offset; // first column after the locally scanned ones
+    uint8_t  cols;
+    bool     present;
+    uint8_t  errors;
+    uint16_t probe_interval;
+    uint16_t probe_timer;
+} slave_module_t;
+
+static slave_module_t modules[] = {
+    { .address = SLAVE_I2C_ADDRESS_RIGHT,  .col_offset = 0,  .cols = 8 },
+    { .address = SLAVE_I2C_ADDRESS_ARROW,  .col_offset = 8,  .cols = 3 },
+    { .address = SLAVE_I2C_ADDRESS_NUMPAD, .col_offset = 11, .cols = 4 },
+};
+
 /* Set 0 if debouncing isn't needed */
 
 #ifndef DEBOUNCE
@@ -120,7 +153,7 @@ uint8_t matrix_cols(void) {
     return MATRIX_COLS;
 }
 
-i2c_status_t i2c_transaction(uint8_t address, uint32_t mask, uint8_t col_offset);
+static bool modules_scan(void);
 
 //this replases tmk code
 void matrix_setup(void){
@@ -144,11 +177,20 @@ void matrix_init(void) {
         matrix_debouncing[i] = 0;
     }
 
+    // probe all modules on the first scan
+    for (uint8_t i = 0; i < ARRAY_SIZE(modules); i++) {
+        modules[i].present = false;
+        modules[i].errors = 0;
+        modules[i].probe_interval = 0;
+        modules[i].probe_timer = timer_read();
+    }
+
     matrix_init_kb();
 }
 
 uint8_t matrix_scan(void)
 {
+    bool changed = false;
 
 #if (DIODE_DIRECTION == COL2ROW)
 
@@ -189,32 +231,21 @@ uint8_t matrix_scan(void)
 #   if (DEBOUNCE > 0)
         if (debouncing && (timer_elapsed(debouncing_time) > DEBOUNCE)) {
             for (uint8_t i = 0; i < MATRIX_ROWS; i++) {
-                matrix[i] = matrix_debouncing[i];
+                //only the local columns, the rest belongs to the modules
+                matrix_row_t row = (matrix[i] & ~LOCAL_COLS_MASK) | matrix_debouncing[i];
+                changed |= (row != matrix[i]);
+                matrix[i] = row;
             }
             debouncing = false;
         }
+#   else
+        changed = true;
 #   endif
 
-if (i2c_transaction(SLAVE_I2C_ADDRESS_RIGHT, 0x3F, 0)) {
-    for (uint8_t i = 0; i < MATRIX_ROWS ; i++) {
-        matrix[i] &= 0x3F; //mask bits to keep
-    }
-}
-
-if (i2c_transaction(SLAVE_I2C_ADDRESS_ARROW, 0X3FFF, 8)) {
-    for (uint8_t i = 0; i < MATRIX_ROWS ; i++) {
-        matrix[i] &= 0x3FFF; //mask bits to keep
-    }
-}
-
-if (i2c_transaction(SLAVE_I2C_ADDRESS_NUMPAD, 0x1FFFF, 11)) {
-    for (uint8_t i = 0; i < MATRIX_ROWS ; i++) {
-        matrix[i] &= 0x1FFFF; //mask bits to keep
-    }
-}
+    changed |= modules_scan();
 
     matrix_scan_kb();
-    return 1;
+    return changed;
 }
 
 inline
@@ -386,14 +417,63 @@ static void unselect_cols(void)
 #endif
 
 // Complete rows from other modules over i2c
-i2c_status_t i2c_transaction(uint8_t address, uint32_t mask, uint8_t col_offset) {
-    uint8_t data[MATRIX_ROWS + 1];
-    i2c_status_t status = i2c_read_register(address, 0x01, data, (MATRIX_ROWS + 1), 5);
+static matrix_row_t module_mask(const slave_module_t *module) {
+    return ((((matrix_row_t)1) << module->cols) - 1) << (MATRIX_COLS_SCANNED + module->col_offset);
+}
+
+static bool module_read(slave_module_t *module, uint8_t *data) {
+    i2c_status_t status = i2c_read_register(module->address, 0x01, data, (MATRIX_ROWS + 1), MODULE_I2C_TIMEOUT);
+    return status == I2C_STATUS_SUCCESS && data[0] == SLAVE_I2C_MARKER;
+}
+
+static bool module_merge(const slave_module_t *module, const uint8_t *data) {
+    matrix_row_t mask = module_mask(module);
+    bool changed = false;
+
+    for (uint8_t i = 0; i < MATRIX_ROWS; i++) { //assemble slave matrix in main matrix
+        matrix_row_t row = (matrix[i] & ~mask);
+        if (data) {
+            row |= ((matrix_row_t)data[i + 1] << (MATRIX_COLS_SCANNED + module->col_offset)) & mask;
+        }
+        changed |= (row != matrix[i]);
+        matrix[i] = row;
+    }
+
+    return changed;
+}
 
-    for (uint8_t i = 0; i < (MATRIX_ROWS) && status >= 0; i++) { //assemble slave matrix in main matrix
-        matrix[i] &= mask;  //mask bits to keep
-        matrix[i] |= ((uint32_t)data[i+1] << (MATRIX_COLS_SCANNED + col_offset)); //add new bits at the end
+static bool modules_scan(void) {
+    uint8_t data[MATRIX_ROWS + 1];
+    bool changed = false;
+
+    for (uint8_t i = 0; i < ARRAY_SIZE(modules); i++) {
+        slave_module_t *module = &modules[i];
+
+        if (module->present) {
+            if (module_read(module, data)) {
+                module->errors = 0;
+                changed |= module_merge(module, data);
+            } else if (++module->errors >= ERROR_DISCONNECT_COUNT) {
+                //detached, release its keys and start probing
+                dprintf("dc01: module 0x%02X detached\n", module->address);
+                module->present = false;
+                module->probe_interval = MODULE_PROBE_INTERVAL_MIN;
+                module->probe_timer = timer_read();
+                changed |= module_merge(module, NULL);
+            }
+            //otherwise keep the last state through a few failed reads
+        } else if (timer_elapsed(module->probe_timer) >= module->probe_interval) {
+            module->probe_timer = timer_read();
+            if (module_read(module, data)) {
+                dprintf("dc01: module 0x%02X attached\n", module->address);
+                module->present = true;
+                module->errors = 0;
+                changed |= module_merge(module, data);
+            } else {
+                module->probe_interval = MIN(MAX(module->probe_interval * 2, MODULE_PROBE_INTERVAL_MIN), MODULE_PROBE_INTERVAL_MAX);
+            }
+        }
     }
 
-    return status;
+    return changed;
 }
@@ -2,7 +2,8 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "quantum.h"
-#include "analog.h"
+#include <stdlib.h>
+#include <hal.h>
 
 joystick_config_t joystick_axes[JOYSTICK_AXIS_COUNT] = {
     [0] = JOYSTICK_AXIS_VIRTUAL,
@@ -11,6 +12,54 @@ joystick_config_t joystick_axes[JOYSTICK_AXIS_COUNT] = {
     [3] = JOYSTICK_AXIS_VIRTUAL
 };
 
+// Oversampling depth per axis; the ADC free-runs over GP26-GP29 and DMA
+// fills this ring, so reading the sticks never waits on a conversion.
+#ifndef NUMPAD_ADC_OVERSAMPLING
+#    define NUMPAD_ADC_OVERSAMPLING 16
+#endif
+// Axis changes smaller than this (in raw 12-bit ADC counts) are ignored
+#ifndef NUMPAD_AXIS_DEADBAND
+#    define NUMPAD_AXIS_DEADBAND 8
+#endif
+// Minimum time between joystick state updates, in ms (1 = 1 kHz)
+#ifndef NUMPAD_JOYSTICK_INTERVAL
+#    define NUMPAD_JOYSTICK_INTERVAL 1
+#endif
+
+#define NUMPAD_ADC_CHANNELS 4
+
+// Buttons and d-pad are all on the same port, active low
+#define PORT_MASK(pin) (1UL << PAL_PAD(pin))
+#define HAT_SHIFT PAL_PAD(GP10) // Up, Down, Left, Right on GP10-GP13
+
+static const pin_t button_pins[] = {GP16, GP18, GP17, GP15, GP14, GP19};
+
+// Hat value for each up/down/left/right combination; up wins over down and
+// left wins over right.
+static const int8_t hat_lut[16] = {
+    // none, U, D, U+D
+    -1, 0, 4, 0,
+    // L, U+L, D+L, U+D+L
+    6, 7, 5, 7,
+    // R, U+R, D+R, U+D+R
+    2, 1, 3, 1,
+    // L+R, U+L+R, D+L+R, U+D+L+R
+    6, 7, 5, 7,
+};
+
+static adcsample_t adc_ring[NUMPAD_ADC_OVERSAMPLING * NUMPAD_ADC_CHANNELS];
+
+static const ADCConversionGroup adc_group = {
+    .circular     = true,
+    .num_channels = NUMPAD_ADC_CHANNELS,
+    .channel_mask = 0x0F, // ADC0-3 = GP26-GP29
+};
+
+static uint16_t button_state = 0;
+static int8_t   hat_state    = -1;
+static int16_t  axis_state[NUMPAD_ADC_CHANNELS];
+static uint16_t joystick_timer = 0;
+
 void keyboard_post_init_kb(void) {
     gpio_set_pin_input_high(GP10); // Up1
     gpio_set_pin_input_high(GP11); // Down1
@@ -23,68 +72,70 @@ void keyboard_post_init_kb(void) {
     gpio_set_pin_input_high(GP18);
     gpio_set_pin_input_high(GP19);
 
+    palSetLineMode(GP26, PAL_MODE_INPUT_ANALOG);
+    palSetLineMode(GP27, PAL_MODE_INPUT_ANALOG);
+    palSetLineMode(GP28, PAL_MODE_INPUT_ANALOG);
+    palSetLineMode(GP29, PAL_MODE_INPUT_ANALOG);
+
+    for (uint8_t i = 0; i < NUMPAD_ADC_CHANNELS; i++) {
+        axis_state[i] = INT16_MIN;
+    }
+
+    adcStart(&ADCD1, NULL);
+    adcStartConversion(&ADCD1, &adc_group, adc_ring, NUMPAD_ADC_OVERSAMPLING);
+
     keyboard_post_init_user();
 }
 
-void set_button_state(int btn, bool state) {
-    if (state) {
-        unregister_joystick_button(btn);
-    }
-    else {
-        register_joystick_button(btn);
+static int16_t read_axis(uint8_t channel) {
+    uint32_t sum = 0;
+    for (uint8_t i = 0; i < NUMPAD_ADC_OVERSAMPLING; i++) {
+        sum += adc_ring[i * NUMPAD_ADC_CHANNELS + channel];
     }
+    return sum / NUMPAD_ADC_OVERSAMPLING;
 }
 
 void housekeeping_task_kb(void) {
-    set_button_state(0, gpio_read_pin(GP16));
-    set_button_state(1, gpio_read_pin(GP18));
-    set_button_state(2, gpio_read_pin(GP17));
-    set_button_state(3, gpio_read_pin(GP15));
-    set_button_state(4, gpio_read_pin(GP14));
-    set_button_state(5, gpio_read_pin(GP19));
-    bool up = !gpio_read_pin(10);
-    bool down = !gpio_read_pin(11);
-    bool left = !gpio_read_pin(12);
-    bool right = !gpio_read_pin(13);
-    if (up) {
-        if (left) {
-            joystick_set_hat(7);
-        }
-        else if (right) {
-            joystick_set_hat(1);
-        }
-        else {
-            joystick_set_hat(0);
-        }
+    if (timer_elapsed(joystick_timer) < NUMPAD_JOYSTICK_INTERVAL) {
+        return;
     }
-    else if (down) {
-        if (left) {
-            joystick_set_hat(5);
-        }
-        else if (right) {
-            joystick_set_hat(3);
-        }
-        else {
-            joystick_set_hat(4);
+    joystick_timer = timer_read();
+
+    // The joystick state is only touched when something changed, so a
+    // report goes out only then.
+    uint32_t port    = ~palReadPort(PAL_PORT(GP10));
+    uint16_t buttons = 0;
+    for (uint8_t i = 0; i < ARRAY_SIZE(button_pins); i++) {
+        if (port & PORT_MASK(button_pins[i])) {
+            buttons |= 1 << i;
         }
     }
-    else if (left) {
-        joystick_set_hat(6);
+
+    uint16_t changed = buttons ^ button_state;
+    for (uint8_t i = 0; changed; i++, changed >>= 1) {
+        if (changed & 1) {
+            if (buttons & (1 << i)) {
+                register_joystick_button(i);
+            } else {
+                unregister_joystick_button(i);
+            }
+        }
     }
-    else if (right) {
-        joystick_set_hat(2);
+    button_state = buttons;
+
+    int8_t hat = hat_lut[(port >> HAT_SHIFT) & 0x0F];
+    if (hat != hat_state) {
+        hat_state = hat;
+        joystick_set_hat(hat);
     }
-    else {
-        joystick_set_hat(-1);
+
+    for (uint8_t i = 0; i < NUMPAD_ADC_CHANNELS; i++) {
+        int16_t analog = read_axis(i);
+        if (abs(analog - axis_state[i]) > NUMPAD_AXIS_DEADBAND) {
+            axis_state[i] = analog;
+            joystick_set_axis(i, analog);
+        }
     }
-    int16_t analog = analogReadPin(GP26);
-    joystick_set_axis(0, analog);
-    analog = analogReadPin(GP27);
-    joystick_set_axis(1, analog);
-    analog = analogReadPin(GP28);
-    joystick_set_axis(2, analog);
-    analog = analogReadPin(GP29);
-    joystick_set_axis(3, analog);
 }
 
 bool rgb_matrix_indicators_advanced_kb(uint8_t led_min, uint8_t led_max) {
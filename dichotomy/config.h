@@ -24,6 +24,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #define ONESHOT_TIMEOUT 500
 
+/* receiver bridge frame */
+#define WIRELESS_FRAME_SIZE 11
+
 /*
  * Feature disable options
  *  These options are also useful to firmware size reduction.
@@ -1,62 +1,33 @@
 #include "dichotomy.h"
 
-//#include "uart.h"
+/* trackball motion received but not yet reported */
+static int16_t motion_x, motion_y, motion_v, motion_h;
 
-bool pointing_device_task(void){
-	/*report_mouse_t currentReport = {};
-    uint32_t timeout = 0;
-
-    //the m character requests the RF slave to send the mouse report
-    uart_write('m');
+static int16_t add_clamped(int16_t total, int8_t delta) {
+    int32_t sum = (int32_t)total + delta;
+    return sum > INT16_MAX ? INT16_MAX : sum < INT16_MIN ? INT16_MIN : sum;
+}
 
-    //trust the external inputs completely, erase old data
-    uint8_t uart_data[5] = {0};
+void dichotomy_add_motion(int8_t x, int8_t y, int8_t v, int8_t h) {
+    motion_x = add_clamped(motion_x, x);
+    motion_y = add_clamped(motion_y, y);
+    motion_v = add_clamped(motion_v, v);
+    motion_h = add_clamped(motion_h, h);
+}
 
-    //there are 10 bytes corresponding to 10 columns, and an end byte
-    for (uint8_t i = 0; i < 5; i++) {
-        //wait for the serial data, timeout if it's been too long
-        //this only happened in testing with a loose wire, but does no
-        //harm to leave it in here
-        while(!uart_available()){
-            timeout++;
-            if (timeout > 10000){
-		xprintf("\r\nTIMED OUT");
-                break;
-            }
-        }
-	xprintf("\r\nGOT DATA for %d",i);
-        uart_data[i] = uart_read();
-    }
+// report as much as fits, the rest goes out with the next report
+static int16_t take_motion(int16_t *total, int16_t min, int16_t max) {
+    int16_t value = *total < min ? min : *total > max ? max : *total;
+    *total -= value;
+    return value;
+}
 
-    //check for the end packet, bytes 1-4 are movement and scroll
-    //but byte 5 has bits 0-3 for the scroll button state
-	//(1000 if pressed, 0000 if not) and bits 4-7 are always 1
-	//We can use this to verify the report sent properly.
-    if (uart_data[4] == 0x0F || uart_data[4] == 0x8F)
-    {
-	xprintf("\r\nREQUESTED MOUSE, RECEIVED %i, %i, %i, %i, %i",uart_data[0],uart_data[1],uart_data[2],uart_data[3],uart_data[4]);
-		currentReport = pointing_device_get_report();
-        //shifting and transferring the info to the mouse report varaible
-        //mouseReport.x = 127 max -127 min
-		currentReport.x = (int8_t) uart_data[0];
-        //mouseReport.y = 127 max -127 min
-		currentReport.y = (int8_t) uart_data[1];
-        //mouseReport.v = 127 max -127 min (scroll vertical)
-		currentReport.v = (int8_t) uart_data[2];
-        //mouseReport.h = 127 max -127 min (scroll horizontal)
-		currentReport.h = (int8_t) uart_data[3];
-        //mouseReport.buttons = 0x31 max (bitmask for mouse buttons 1-5) 0x00 min
-		//mouse buttons 1 and 2 are handled by the keymap, but not 3
-		if (uart_data[4] == 0x0F) { //then 3 is not pressed
-			currentReport.buttons &= ~MOUSE_BTN3; //MOUSE_BTN3 is def in report.h
-		} else { //3 must be pressed
-			currentReport.buttons |= MOUSE_BTN3;
-		}
-		pointing_device_set_report(currentReport);
-    } else {
-	xprintf("\r\nRequested packet, data 4 was %d",uart_data[4]);
-    }*/
-    return pointing_device_send();
+report_mouse_t pointing_device_driver_get_report(report_mouse_t mouse_report) {
+    mouse_report.x = take_motion(&motion_x, XY_REPORT_MIN, XY_REPORT_MAX);
+    mouse_report.y = take_motion(&motion_y, XY_REPORT_MIN, XY_REPORT_MAX);
+    mouse_report.v = take_motion(&motion_v, HV_REPORT_MIN, HV_REPORT_MAX);
+    mouse_report.h = take_motion(&motion_h, HV_REPORT_MIN, HV_REPORT_MAX);
+    return mouse_report;
 }
 
 void led_init(void) {
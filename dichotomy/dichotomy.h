@@ -4,6 +4,8 @@
 #include "pointing_device.h"
 #include "quantum.h"
 
+void dichotomy_add_motion(int8_t x, int8_t y, int8_t v, int8_t h);
+
 #define red_led_off()   gpio_write_pin_high(F6)
 #define red_led_on()    gpio_write_pin_low(F6)
 #define blu_led_off()   gpio_write_pin_high(F5)
@@ -2,5 +2,6 @@ POINTING_DEVICE_DRIVER = custom
 CUSTOM_MATRIX = yes    # Remote matrix from the wireless bridge
 
 # # project specific files
-SRC += matrix.c
+SRC += matrix.c wireless_receiver.c
+VPATH += keyboards/lib/wireless_receiver
 UART_DRIVER_REQUIRED = yes
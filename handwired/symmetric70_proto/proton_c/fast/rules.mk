@@ -1,3 +1,5 @@
 CUSTOM_MATRIX = yes
 SRC += matrix_common.c
 SRC += matrix_fast/matrix.c
+# gpio_extr.h
+VPATH += keyboards/lib/matrix_portscan
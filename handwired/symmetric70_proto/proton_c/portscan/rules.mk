@@ -0,0 +1,4 @@
+CUSTOM_MATRIX = yes
+SRC += matrix_common.c
+SRC += matrix_portscan.c
+VPATH += keyboards/lib/matrix_portscan
@@ -0,0 +1,2 @@
+VPATH += keyboards/lib/split_sync
+SRC += split_sync.c
@@ -16,6 +16,7 @@
 
 #include "tractyl_manuform.h"
 #include "transactions.h"
+#include "split_sync.h"
 #include <string.h>
 
 #ifdef CONSOLE_ENABLE
@@ -320,43 +321,21 @@ void eeconfig_init_kb(void) {
 
 void matrix_power_up(void) { pointing_device_task(); }
 
-void charybdis_config_sync_handler(uint8_t initiator2target_buffer_size, const void* initiator2target_buffer, uint8_t target2initiator_buffer_size, void* target2initiator_buffer) {
-    if (initiator2target_buffer_size == sizeof(g_charybdis_config)) {
-        memcpy(&g_charybdis_config, initiator2target_buffer, sizeof(g_charybdis_config));
-    }
-}
+static charybdis_config_t g_charybdis_config_sent;
+static split_sync_block_t g_charybdis_sync_blocks[] = {
+    SPLIT_SYNC_BLOCK(g_charybdis_config, g_charybdis_config_sent),
+};
 
 void keyboard_post_init_kb(void) {
     maybe_update_pointing_device_cpi(&g_charybdis_config);
-    transaction_register_rpc(RPC_ID_KB_CONFIG_SYNC, charybdis_config_sync_handler);
+    split_sync_init(RPC_ID_KB_CONFIG_SYNC, g_charybdis_sync_blocks, ARRAY_SIZE(g_charybdis_sync_blocks));
 
     keyboard_post_init_user();
 }
 
 void housekeeping_task_kb(void) {
-    if (is_keyboard_master()) {
-        // Keep track of the last state, so that we can tell if we need to propagate to slave
-        static charybdis_config_t last_charybdis_config = {0};
-        static uint32_t           last_sync             = 0;
-        bool                      needs_sync            = false;
-
-        // Check if the state values are different
-        if (memcmp(&g_charybdis_config, &last_charybdis_config, sizeof(g_charybdis_config))) {
-            needs_sync = true;
-            memcpy(&last_charybdis_config, &g_charybdis_config, sizeof(g_charybdis_config));
-        }
-        // Send to slave every 500ms regardless of state change
-        if (timer_elapsed32(last_sync) > 500) {
-            needs_sync = true;
-        }
-
-        // Perform the sync if requested
-        if (needs_sync) {
-            if (transaction_rpc_send(RPC_ID_KB_CONFIG_SYNC, sizeof(g_charybdis_config), &g_charybdis_config)) {
-                last_sync = timer_read32();
-            }
-        }
-    }
+    // Propagate config changes to the slave
+    split_sync_task();
     // no need for user function, is called already
 }
 
@@ -15,7 +15,7 @@
  */
 
 // OLED animation
-#include "lib/bongocat.h"
+#include "bongocat.h"
 #include "lib/galaxy.h"
 #include "lib/wave.c"
 
@@ -1,4 +1,6 @@
-SRC += lib/bongocat.c
+VPATH += keyboards/lib/bongocat keyboards/lib/oled_anim
+SRC += bongocat.c \
+       oled_anim.c
 SRC += lib/galaxy.c
 
 RGB_MATRIX_CUSTOM_USER = yes
@@ -17,7 +17,7 @@
 #include "quantum.h"
 
 // OLED animation
-#include "lib/bongocat.h"
+#include "bongocat.h"
 
 #ifdef OLED_ENABLE
 bool oled_task_kb(void) {
@@ -1 +1,3 @@
-SRC += lib/bongocat.c
+VPATH += keyboards/lib/bongocat keyboards/lib/oled_anim
+SRC += bongocat.c \
+       oled_anim.c
@@ -5,6 +5,7 @@
 #include "hotdox76v2.h"
 #include <string.h>
 #include <transactions.h>
+#include "split_sync.h"
 #include "oled_font_lib/logo2.h"
 #include "oled_font_lib/ext_font.h"
 
@@ -65,13 +66,12 @@ typedef struct _master_to_slave_t {
     int  cur_alp_index;
     char current_alp[7];
 } master_to_slave_t;
-master_to_slave_t m2s;
+master_to_slave_t        m2s;
+static master_to_slave_t m2s_sent;
 
-typedef struct _slave_to_master_t {
-    int  cur_alp_index;
-    char current_alp[7];
-} slave_to_master_t;
-slave_to_master_t s2m;
+static split_sync_block_t m2s_blocks[] = {
+    SPLIT_SYNC_BLOCK(m2s, m2s_sent),
+};
 
 oled_rotation_t oled_init_kb(oled_rotation_t rotation) {
     strcpy((char *)(m2s.current_alp), "[    ]");
@@ -82,14 +82,6 @@ oled_rotation_t oled_init_kb(oled_rotation_t rotation) {
 
     m2s.cur_alp_index = 1;
 
-    strcpy((char *)(s2m.current_alp), "[    ]");
-    s2m.current_alp[1] = UNC;
-    s2m.current_alp[2] = UNC;
-    s2m.current_alp[3] = UNC;
-    s2m.current_alp[4] = UNC;
-
-    s2m.cur_alp_index = 1;
-
     if (is_keyboard_left()) {
         return OLED_ROTATION_180;
     } else {
@@ -166,11 +158,7 @@ void render_cur_input_helper_fun(uint8_t start_line, const char *data, uint8_t g
 
 void render_cur_input(void) {
     render_cur_input_helper_fun(0, "INPUTS:", 6, 7);
-    if (is_keyboard_master()) {
-        render_cur_input_helper_fun(1, (const char *)(m2s.current_alp), 12, 6);
-    } else {
-        render_cur_input_helper_fun(1, (const char *)(s2m.current_alp), 12, 6);
-    }
+    render_cur_input_helper_fun(1, (const char *)(m2s.current_alp), 12, 6);
     return;
 }
 
@@ -248,16 +236,8 @@ bool process_record_kb(uint16_t keycode, keyrecord_t *record) {
     return true;
 }
 
-void user_sync_alpa_slave_handler(uint8_t in_buflen, const void *in_data, uint8_t out_buflen, void *out_data) {
-    const master_to_slave_t *m2s_p = (const master_to_slave_t *)in_data;
-    s2m.cur_alp_index              = m2s_p->cur_alp_index;
-    for (size_t i = 0; i < 7; i++) {
-        s2m.current_alp[i] = m2s_p->current_alp[i];
-    }
-}
-
 void keyboard_post_init_kb(void) {
-    transaction_register_rpc(KEYBOARD_CURRENT_ALPA_SYNC, user_sync_alpa_slave_handler);
+    split_sync_init(KEYBOARD_CURRENT_ALPA_SYNC, m2s_blocks, ARRAY_SIZE(m2s_blocks));
     keyboard_post_init_user();
 }
 
@@ -266,17 +246,9 @@ void housekeeping_task_kb(void) {
         if (!is_oled_on()) {
             m2s.cur_alp_index = 1;
         }
-        // Interact with slave every 200ms
-        static uint32_t last_sync = 0;
-        if (timer_elapsed32(last_sync) > 200) {
-            if (transaction_rpc_exec(KEYBOARD_CURRENT_ALPA_SYNC, sizeof(m2s), &m2s, sizeof(s2m), &s2m)) {
-                last_sync = timer_read32();
-                dprint("Slave sync successed!\n");
-            } else {
-                dprint("Slave sync failed!\n");
-            }
-        }
     }
+    // Send the typed characters to the slave when they change
+    split_sync_task();
 }
 
 #endif
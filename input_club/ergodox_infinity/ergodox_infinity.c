@@ -84,6 +84,17 @@ static uint16_t cie_lightness(uint16_t v) {
 }
 
 void ergodox_infinity_lcd_color(uint16_t r, uint16_t g, uint16_t b) {
+    // The channels start out at 0, matching an initial black
+    static uint16_t last_r = 0, last_g = 0, last_b = 0;
+
+    // Skip the float conversions when the colour didn't change
+    if (r == last_r && g == last_g && b == last_b) {
+        return;
+    }
+    last_r = r;
+    last_g = g;
+    last_b = b;
+
     CHANNEL_RED.CnV   = cie_lightness(r);
     CHANNEL_GREEN.CnV = cie_lightness(g);
     CHANNEL_BLUE.CnV  = cie_lightness(b);
@@ -245,24 +256,43 @@ static void format_layer_bitmap_string(char* buffer, uint8_t offset) {
 }
 
 __attribute__((weak)) void st7565_task_user(void) {
+    // Only redraw what changed, so idle cycles leave the display buffer alone
+    static bool          drawn = false;
+    static led_t         drawn_leds;
+    static layer_state_t drawn_layer_state, drawn_default_layer_state;
+
     if (is_keyboard_master()) {
-        // Draw led and layer status
+        // Draw led status
         led_t leds = host_keyboard_led_state();
-        if(leds.num_lock) { st7565_write("Num ", false); }
-        if(leds.caps_lock) { st7565_write("Cap ", false); }
-        if(leds.scroll_lock) { st7565_write("Scrl ", false); }
-        if(leds.compose) { st7565_write("Com ", false); }
-        if(leds.kana) { st7565_write("Kana", false); }
-        st7565_advance_page(true);
-
-        char layer_buffer[16 + 5];  // 3 spaces and one null terminator
-        st7565_set_cursor(0, 1);
-        format_layer_bitmap_string(layer_buffer, 0);
-        st7565_write_ln(layer_buffer, false);
-        format_layer_bitmap_string(layer_buffer, 16);
-        st7565_write_ln(layer_buffer, false);
-        st7565_write_ln("  1=On    D=Default", false);
-    } else {
+        if (!drawn || leds.raw != drawn_leds.raw) {
+            drawn_leds = leds;
+            st7565_set_cursor(0, 0);
+            if(leds.num_lock) { st7565_write("Num ", false); }
+            if(leds.caps_lock) { st7565_write("Cap ", false); }
+            if(leds.scroll_lock) { st7565_write("Scrl ", false); }
+            if(leds.compose) { st7565_write("Com ", false); }
+            if(leds.kana) { st7565_write("Kana", false); }
+            st7565_advance_page(true);
+        }
+
+        // Draw layer status
+        if (!drawn || layer_state != drawn_layer_state || default_layer_state != drawn_default_layer_state) {
+            drawn_layer_state         = layer_state;
+            drawn_default_layer_state = default_layer_state;
+
+            char layer_buffer[16 + 5];  // 3 spaces and one null terminator
+            st7565_set_cursor(0, 1);
+            format_layer_bitmap_string(layer_buffer, 0);
+            st7565_write_ln(layer_buffer, false);
+            format_layer_bitmap_string(layer_buffer, 16);
+            st7565_write_ln(layer_buffer, false);
+        }
+
+        if (!drawn) {
+            st7565_set_cursor(0, 3);
+            st7565_write_ln("  1=On    D=Default", false);
+        }
+    } else if (!drawn) {
         // Draw logo
         static const char qmk_logo[] = {
             0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F, 0x90, 0x91, 0x92, 0x93, 0x94,
@@ -273,6 +303,8 @@ __attribute__((weak)) void st7565_task_user(void) {
         st7565_write(qmk_logo, false);
         st7565_write("  Infinity  Ergodox  ", false);
     }
+
+    drawn = true;
 }
 #endif
 
@@ -34,8 +34,6 @@
 #include <ch.h>
 #include <hal.h>
 
-static uint8_t i2c_address;
-
 I2CDriver *drivers[I2C_COUNT];
 
 static const I2CConfig i2cconfig = {
@@ -90,7 +88,7 @@ i2c_status_t i2c_start(uint8_t index, uint8_t address) {
     if(index >= I2C_COUNT) {
         return I2C_STATUS_ERROR;
     }
-    i2c_address = address;
+    (void)address;
     i2cStart(drivers[index], &i2cconfig);
     return I2C_STATUS_SUCCESS;
 }
@@ -99,9 +97,8 @@ i2c_status_t i2c_transmit(uint8_t index, uint8_t address, const uint8_t* data, u
     if(index >= I2C_COUNT) {
         return I2C_STATUS_ERROR;
     }
-    i2c_address = address;
     i2cStart(drivers[index], &i2cconfig);
-    msg_t status = i2cMasterTransmitTimeout(drivers[index], (i2c_address >> 1), data, length, 0, 0, TIME_MS2I(timeout));
+    msg_t status = i2cMasterTransmitTimeout(drivers[index], (address >> 1), data, length, 0, 0, TIME_MS2I(timeout));
     return chibios_to_qmk(&status);
 }
 
@@ -109,9 +106,8 @@ i2c_status_t i2c_receive(uint8_t index, uint8_t address, uint8_t* data, uint16_t
     if(index >= I2C_COUNT) {
         return I2C_STATUS_ERROR;
     }
-    i2c_address = address;
     i2cStart(drivers[index], &i2cconfig);
-    msg_t status = i2cMasterReceiveTimeout(drivers[index], (i2c_address >> 1), data, length, TIME_MS2I(timeout));
+    msg_t status = i2cMasterReceiveTimeout(drivers[index], (address >> 1), data, length, TIME_MS2I(timeout));
     return chibios_to_qmk(&status);
 }
 
@@ -119,7 +115,6 @@ i2c_status_t i2c_write_register(uint8_t index, uint8_t devaddr, uint8_t regaddr,
     if(index >= I2C_COUNT) {
         return I2C_STATUS_ERROR;
     }
-    i2c_address = devaddr;
     i2cStart(drivers[index], &i2cconfig);
 
     uint8_t complete_packet[length + 1];
@@ -128,7 +123,7 @@ i2c_status_t i2c_write_register(uint8_t index, uint8_t devaddr, uint8_t regaddr,
     }
     complete_packet[0] = regaddr;
 
-    msg_t status = i2cMasterTransmitTimeout(drivers[index], (i2c_address >> 1), complete_packet, length + 1, 0, 0, TIME_MS2I(timeout));
+    msg_t status = i2cMasterTransmitTimeout(drivers[index], (devaddr >> 1), complete_packet, length + 1, 0, 0, TIME_MS2I(timeout));
     return chibios_to_qmk(&status);
 }
 
@@ -136,9 +131,8 @@ i2c_status_t i2c_read_register(uint8_t index, uint8_t devaddr, uint8_t regaddr,
     if(index >= I2C_COUNT) {
         return I2C_STATUS_ERROR;
     }
-    i2c_address = devaddr;
     i2cStart(drivers[index], &i2cconfig);
-    msg_t status = i2cMasterTransmitTimeout(drivers[index], (i2c_address >> 1), &regaddr, 1, data, length, TIME_MS2I(timeout));
+    msg_t status = i2cMasterTransmitTimeout(drivers[index], (devaddr >> 1), &regaddr, 1, data, length, TIME_MS2I(timeout));
     return chibios_to_qmk(&status);
 }
 
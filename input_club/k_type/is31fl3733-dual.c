@@ -20,9 +20,13 @@
 #include "i2c_master.h"
 #include "gpio.h"
 #include "wait.h"
+#include "debug.h"
+#include <ch.h>
 
 #define IS31FL3733_PWM_REGISTER_COUNT 192
 #define IS31FL3733_LED_CONTROL_REGISTER_COUNT 24
+#define IS31FL3733_PWM_CHUNK_SIZE 16
+#define IS31FL3733_PAGE_UNKNOWN 0xFF
 
 #ifndef IS31FL3733_I2C_TIMEOUT
 #    define IS31FL3733_I2C_TIMEOUT 100
@@ -48,6 +52,16 @@
 #    define IS31FL3733_GLOBAL_CURRENT 0xFF
 #endif
 
+// With two buses, the second one is flushed from its own thread so both
+// transfers are on the wire at the same time.
+#if defined(USE_I2C2) && !defined(IS31FL3733_NO_CONCURRENT_FLUSH)
+#    define IS31FL3733_CONCURRENT_FLUSH
+#endif
+
+#ifndef IS31FL3733_FLUSH_THREAD_STACK_SIZE
+#    define IS31FL3733_FLUSH_THREAD_STACK_SIZE 512
+#endif
+
 #ifndef IS31FL3733_SYNC_1
 #    define IS31FL3733_SYNC_1 IS31FL3733_SYNC_NONE
 #endif
@@ -81,57 +95,112 @@ const uint8_t driver_sync[IS31FL3733_DRIVER_COUNT] = {
 // We could optimize this and take out the unused registers from these
 // buffers and the transfers in is31fl3733_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
+// pwm_buffer_dirty has one bit per 16 byte chunk of pwm_buffer, so only
+// the chunks that changed are transferred.
 typedef struct is31fl3733_driver_t {
-    uint8_t pwm_buffer[IS31FL3733_PWM_REGISTER_COUNT];
-    bool    pwm_buffer_dirty;
-    uint8_t led_control_buffer[IS31FL3733_LED_CONTROL_REGISTER_COUNT];
-    bool    led_control_buffer_dirty;
+    uint8_t  pwm_buffer[IS31FL3733_PWM_REGISTER_COUNT];
+    uint16_t pwm_buffer_dirty;
+    uint8_t  led_control_buffer[IS31FL3733_LED_CONTROL_REGISTER_COUNT];
+    bool     led_control_buffer_dirty;
+    uint8_t  selected_page;
 } PACKED is31fl3733_driver_t;
 
 is31fl3733_driver_t driver_buffers[IS31FL3733_DRIVER_COUNT] = {{
     .pwm_buffer               = {0},
-    .pwm_buffer_dirty         = false,
+    .pwm_buffer_dirty         = 0,
     .led_control_buffer       = {0},
     .led_control_buffer_dirty = false,
+    .selected_page            = IS31FL3733_PAGE_UNKNOWN,
 }};
 
-void is31fl3733_write_register(uint8_t bus, uint8_t index, uint8_t reg, uint8_t data) {
+bool is31fl3733_write_register(uint8_t bus, uint8_t index, uint8_t reg, uint8_t data) {
 #if IS31FL3733_I2C_PERSISTENCE > 0
     for (uint8_t i = 0; i < IS31FL3733_I2C_PERSISTENCE; i++) {
-        if (i2c_write_register(bus, i2c_addresses[index] << 1, reg, &data, 1, IS31FL3733_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
+        if (i2c_write_register(bus, i2c_addresses[index] << 1, reg, &data, 1, IS31FL3733_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) return true;
     }
+    return false;
 #else
-    i2c_write_register(bus, i2c_addresses[index] << 1, reg, &data, 1, IS31FL3733_I2C_TIMEOUT);
+    return i2c_write_register(bus, i2c_addresses[index] << 1, reg, &data, 1, IS31FL3733_I2C_TIMEOUT) == I2C_STATUS_SUCCESS;
 #endif
 }
 
-void is31fl3733_select_page(uint8_t bus, uint8_t index, uint8_t page) {
-    is31fl3733_write_register(bus, index, IS31FL3733_REG_COMMAND_WRITE_LOCK, IS31FL3733_COMMAND_WRITE_LOCK_MAGIC);
-    is31fl3733_write_register(bus, index, IS31FL3733_REG_COMMAND, page);
+bool is31fl3733_select_page(uint8_t bus, uint8_t index, uint8_t page) {
+    // The page stays selected until it is changed, so skip the unlock
+    // and select when it already is.
+    if (driver_buffers[index].selected_page == page) {
+        return true;
+    }
+
+    // If either write failed the chip may be on any page, so select it
+    // again next time.
+    if (is31fl3733_write_register(bus, index, IS31FL3733_REG_COMMAND_WRITE_LOCK, IS31FL3733_COMMAND_WRITE_LOCK_MAGIC) && is31fl3733_write_register(bus, index, IS31FL3733_REG_COMMAND, page)) {
+        driver_buffers[index].selected_page = page;
+        return true;
+    }
+    driver_buffers[index].selected_page = IS31FL3733_PAGE_UNKNOWN;
+    return false;
 }
 
 void is31fl3733_write_pwm_buffer(uint8_t bus, uint8_t index) {
     // Assumes page 1 is already selected.
-    // Transmit PWM registers in 12 transfers of 16 bytes.
+    // Transmit the dirty 16 byte chunks, merging neighbouring chunks into a
+    // single transfer since the register address auto-increments.
+    uint16_t dirty = driver_buffers[index].pwm_buffer_dirty;
+    uint8_t  chunk = 0;
+
+    while (dirty) {
+        if (!(dirty & 1)) {
+            dirty >>= 1;
+            chunk++;
+            continue;
+        }
 
-    // Iterate over the pwm_buffer contents at 16 byte intervals.
-    for (uint8_t i = 0; i < IS31FL3733_PWM_REGISTER_COUNT; i += 16) {
+        uint8_t count = 0;
+        while (dirty & 1) {
+            dirty >>= 1;
+            count++;
+        }
+
+        uint8_t  reg    = chunk * IS31FL3733_PWM_CHUNK_SIZE;
+        uint16_t length = count * IS31FL3733_PWM_CHUNK_SIZE;
 #if IS31FL3733_I2C_PERSISTENCE > 0
         for (uint8_t j = 0; j < IS31FL3733_I2C_PERSISTENCE; j++) {
-            if (i2c_write_register(bus, i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, 16, IS31FL3733_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
+            if (i2c_write_register(bus, i2c_addresses[index] << 1, reg, driver_buffers[index].pwm_buffer + reg, length, IS31FL3733_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) break;
         }
 #else
-        i2c_write_register(bus, i2c_addresses[index] << 1, i, driver_buffers[index].pwm_buffer + i, 16, IS31FL3733_I2C_TIMEOUT);
+        i2c_write_register(bus, i2c_addresses[index] << 1, reg, driver_buffers[index].pwm_buffer + reg, length, IS31FL3733_I2C_TIMEOUT);
 #endif
+        chunk += count;
     }
 }
 
+#ifdef IS31FL3733_CONCURRENT_FLUSH
+static THD_WORKING_AREA(flush_thread_wa, IS31FL3733_FLUSH_THREAD_STACK_SIZE);
+static binary_semaphore_t flush_start;
+static binary_semaphore_t flush_done;
+
+static THD_FUNCTION(flush_thread, arg) {
+    (void)arg;
+    chRegSetThreadName("is31fl3733");
+
+    while (true) {
+        chBSemWait(&flush_start);
+        is31fl3733_update_pwm_buffers(1, 1);
+        chBSemSignal(&flush_done);
+    }
+}
+#endif
+
 void is31fl3733_init_drivers(void) {
 #if defined(IS31FL3733_SDB_PIN)
     gpio_set_pin_output(IS31FL3733_SDB_PIN);
     gpio_write_pin_high(IS31FL3733_SDB_PIN);
 #endif
 
+    for (int i = 0; i < IS31FL3733_DRIVER_COUNT; i++) {
+        driver_buffers[i].selected_page = IS31FL3733_PAGE_UNKNOWN;
+    }
+
     i2c_init(&I2CD1, I2C1_SCL_PIN, I2C1_SDA_PIN);
 
     is31fl3733_init(0, 0);
@@ -148,6 +217,12 @@ void is31fl3733_init_drivers(void) {
 #    ifdef USE_I2C2
     is31fl3733_update_led_control_registers(1, 1);
 #    endif
+
+#ifdef IS31FL3733_CONCURRENT_FLUSH
+    chBSemObjectInit(&flush_start, true);
+    chBSemObjectInit(&flush_done, true);
+    chThdCreateStatic(flush_thread_wa, sizeof(flush_thread_wa), NORMALPRIO, flush_thread, NULL);
+#endif
 }
 
 void is31fl3733_init(uint8_t bus, uint8_t index) {
@@ -201,7 +276,7 @@ void is31fl3733_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
         driver_buffers[led.driver].pwm_buffer[led.r] = red;
         driver_buffers[led.driver].pwm_buffer[led.g] = green;
         driver_buffers[led.driver].pwm_buffer[led.b] = blue;
-        driver_buffers[led.driver].pwm_buffer_dirty  = true;
+        driver_buffers[led.driver].pwm_buffer_dirty |= (1 << (led.r / IS31FL3733_PWM_CHUNK_SIZE)) | (1 << (led.g / IS31FL3733_PWM_CHUNK_SIZE)) | (1 << (led.b / IS31FL3733_PWM_CHUNK_SIZE));
     }
 }
 
@@ -243,17 +318,18 @@ void is31fl3733_set_led_control_register(uint8_t index, bool red, bool green, bo
 
 void is31fl3733_update_pwm_buffers(uint8_t bus, uint8_t index) {
     if (driver_buffers[index].pwm_buffer_dirty) {
-        is31fl3733_select_page(bus, index, IS31FL3733_COMMAND_PWM);
+        // Stay dirty and try again on the next flush
+        if (!is31fl3733_select_page(bus, index, IS31FL3733_COMMAND_PWM)) return;
 
         is31fl3733_write_pwm_buffer(bus, index);
 
-        driver_buffers[index].pwm_buffer_dirty = false;
+        driver_buffers[index].pwm_buffer_dirty = 0;
     }
 }
 
 void is31fl3733_update_led_control_registers(uint8_t bus, uint8_t index) {
     if (driver_buffers[index].led_control_buffer_dirty) {
-        is31fl3733_select_page(bus, index, IS31FL3733_COMMAND_LED_CONTROL);
+        if (!is31fl3733_select_page(bus, index, IS31FL3733_COMMAND_LED_CONTROL)) return;
 
         for (int i = 0; i < IS31FL3733_LED_CONTROL_REGISTER_COUNT; i++) {
             is31fl3733_write_register(bus, index, i, driver_buffers[index].led_control_buffer[i]);
@@ -264,8 +340,28 @@ void is31fl3733_update_led_control_registers(uint8_t bus, uint8_t index) {
 }
 
 void is31fl3733_flush(void) {
+#ifdef IS31FL3733_FLUSH_TIMING
+    systime_t start = chVTGetSystemTimeX();
+    bool      dirty = false;
+    for (int i = 0; i < IS31FL3733_DRIVER_COUNT; i++) {
+        dirty |= driver_buffers[i].pwm_buffer_dirty != 0;
+    }
+#endif
+
+#ifdef IS31FL3733_CONCURRENT_FLUSH
+    chBSemSignal(&flush_start);
+    is31fl3733_update_pwm_buffers(0, 0);
+    chBSemWait(&flush_done);
+#else
     is31fl3733_update_pwm_buffers(0, 0);
 #    ifdef USE_I2C2
     is31fl3733_update_pwm_buffers(1, 1);
 #    endif
+#endif
+
+#ifdef IS31FL3733_FLUSH_TIMING
+    if (dirty) {
+        dprintf("is31fl3733: flush took %lu us\n", (unsigned long)TIME_I2US(chVTTimeElapsedSinceX(start)));
+    }
+#endif
 }
@@ -84,8 +84,8 @@ extern const is31fl3733_led_t PROGMEM g_is31fl3733_leds[IS31FL3733_LED_COUNT];
 
 void is31fl3733_init_drivers(void);
 void is31fl3733_init(uint8_t bus, uint8_t index);
-void is31fl3733_write_register(uint8_t index, uint8_t addr, uint8_t reg, uint8_t data);
-void is31fl3733_select_page(uint8_t index, uint8_t addr, uint8_t page);
+bool is31fl3733_write_register(uint8_t index, uint8_t addr, uint8_t reg, uint8_t data);
+bool is31fl3733_select_page(uint8_t index, uint8_t addr, uint8_t page);
 
 void is31fl3733_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void is31fl3733_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
@@ -15,7 +15,7 @@
 */
 
 #include "quantum.h"
-#include "lib/bongocat.h"
+#include "bongocat.h"
 #ifdef OLED_ENABLE
 bool oled_task_kb(void) {
     if (!oled_task_user()) { return false; }
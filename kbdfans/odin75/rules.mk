@@ -1,2 +1,4 @@
 OLED_TRANSPORT = spi
-SRC += lib/bongocat.c
+VPATH += keyboards/lib/bongocat keyboards/lib/oled_anim
+SRC += bongocat.c \
+       oled_anim.c
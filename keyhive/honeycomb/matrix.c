@@ -30,7 +30,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "honeycomb.h"
 #include "pointing_device.h"
 #include "report.h"
-#include "uart.h"
+#include "wireless_receiver.h"
 
 #if (MATRIX_COLS <= 8)
 # define print_matrix_header()  print("\nr/c 01234567\n")
@@ -46,8 +46,6 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 # define ROW_SHIFTER  ((uint32_t)1)
 #endif
 
-#define UART_MATRIX_RESPONSE_TIMEOUT 10000
-
 /* matrix state(1:on, 0:off) */
 static matrix_row_t matrix[MATRIX_ROWS];
 //extern int8_t encoderValue;
@@ -81,82 +79,37 @@ uint8_t matrix_cols(void) {
     return MATRIX_COLS;
 }
 
+// There are 3 bytes corresponding to the data, and a checksum
+bool wireless_receiver_decode(const uint8_t uart_data[], matrix_row_t rows[]) {
+    // Check for the end packet, it's our checksum.
+    // Will only be a match if the correct bytes were recieved
+    if (uart_data[3] != (uart_data[0] ^ uart_data[1] ^ uart_data[2])) { // This is an arbitrary checksum calculated by XORing all the data.
+        dprintf("\r\nRequested packet, data 3 was %d",uart_data[3]);
+        return false;
+    }
+
+    // Transferring the keystates to the QMK matrix variable
+	rows[0] = ((uint16_t) uart_data[0] << 8) | ((uint16_t) uart_data[1]);
+	encoderValue += (int8_t) uart_data[2];
+    for (uint8_t i = 0; i < MATRIX_ROWS; i++) {
+		// I've unpacked these into the mirror image of what QMK expects them to be, so...
+		rows[i] = bitrev16(rows[i]);
+		// So I'll reverse it, and this should be fine now.
+    }
+
+    // A mouse report for scrolling would go here, but I don't plan on doing scrolling with the encoder. So.
+    return true;
+}
+
 void matrix_init(void) {
 
     matrix_init_kb();
-    uart_init(1000000);
+    wireless_receiver_init(1000000);
 }
 
 uint8_t matrix_scan(void)
 {
-    uint32_t timeout = 0;
-
-    // The 's' character requests the RF slave to send the matrix
-    uart_write('s');
-
-    // Trust the external keystates entirely, erase the last data
-    uint8_t uart_data[4] = {0};
-
-    // There are 3 bytes corresponding to the data, and a checksum
-    for (uint8_t i = 0; i < 4; i++) {
-        // Wait for the serial data, timeout if it's been too long
-        // This only happened in testing with a loose wire, but does no
-        // harm to leave it in here
-        while(!uart_available()){
-            timeout++;
-            if (timeout > UART_MATRIX_RESPONSE_TIMEOUT) {
-                break;
-            }
-        }
-
-        if (timeout < UART_MATRIX_RESPONSE_TIMEOUT) {
-            uart_data[i] = uart_read();
-        } else {
-            uart_data[i] = 0x00;
-        }
-    }
-
-    // Check for the end packet, it's our checksum.
-    // Will only be a match if the correct bytes were recieved
-    if (uart_data[3] == (uart_data[0] ^ uart_data[1] ^ uart_data[2])) { // This is an arbitrary checksum calculated by XORing all the data.
-        // Transferring the keystates to the QMK matrix variable
-		/* ASSUMING MSB FIRST */
-		matrix[0] = ((uint16_t) uart_data[0] << 8) | ((uint16_t) uart_data[1]);
-		encoderValue += (int8_t) uart_data[2];
-		if ((uart_data[0] | uart_data[1] | uart_data[2])!=0){
-			xprintf("\r\n0x%0X%02X%02X",uart_data[0],uart_data[1], uart_data[2]);
-		}
-		/* OK, TURNS OUT THAT WAS A BAD ASSUMPTION */
-        for (uint8_t i = 0; i < MATRIX_ROWS; i++) {
-			// I've unpacked these into the mirror image of what QMK expects them to be, so...
-			matrix[i] = bitrev16(matrix[i]);
-			// So I'll reverse it, and this should be fine now.
-        }
-
-        // A mouse report for scrolling would go here, but I don't plan on doing scrolling with the encoder. So.
-
-    	report_mouse_t currentReport = {};
-/*
-    	currentReport = pointing_device_get_report();
-            //mouseReport.x = 127 max -127 min
-    	currentReport.x = (int8_t) uart_data[6];
-            //mouseReport.y = 127 max -127 min
-    	currentReport.y = (int8_t) uart_data[7];
-            //mouseReport.v = 127 max -127 min (scroll vertical)
-    	currentReport.v = (int8_t) uart_data[8];
-            //mouseReport.h = 127 max -127 min (scroll horizontal)
-    	currentReport.h = (int8_t) uart_data[9];
-        */
-    	/*
-    	currentReport.x = 0;
-    	currentReport.y = 0;
-    	currentReport.v = 0;
-        currentReport.h = 0;*/
-
-        pointing_device_set_report(currentReport);
-    } else {
-        xprintf("\r\nRequested packet, data 3 was %d",uart_data[3]);
-    }
+    wireless_receiver_scan(matrix);
 
     matrix_scan_kb();
     return 1;
@@ -0,0 +1,151 @@
+/* Copyright 2022 HorrorTroll <https://github.com/HorrorTroll>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "bongocat.h"
+#include "oled_anim.h"
+#include "oled_driver.h"
+#include "progmem.h"
+#include "timer.h"
+#include "wpm.h"
+#include "util.h"
+
+// WPM-responsive animation stuff here
+#define IDLE_FRAMES 5
+#define IDLE_SPEED 10  // below this wpm value your animation will idle
+#define TAP_FRAMES 2
+#define ANIM_WPM_LOWER 20  // above this wpm value typing animation to trigger
+#define ANIM_FRAME_DURATION_MAX 450 // longest animation duration in ms
+#define ANIM_FRAME_DURATION_MIN 100 // shortest animation duration in ms
+#define IDLE_FRAME_DURATION 300  // how long each frame lasts in ms
+#define ANIM_FRAME_RATIO 2.5 // how aggressively animation speeds up with wpm
+#define ANIM_SIZE 512  // 128x32
+
+// Frame numbers in bongocat_data
+#define IDLE_FRAME(n) (n)
+#define PREP_FRAME (IDLE_FRAMES)
+#define TAP_FRAME(n) (IDLE_FRAMES + 1 + (n))
+
+uint32_t curr_anim_duration = 0; // variable animation duration
+uint32_t bongo_timer = 0;
+uint32_t bongo_sleep = 0;
+uint8_t  current_idle_frame = 0;
+uint8_t  current_tap_frame = 0;
+
+// Code containing pixel art, contains:
+// 5 idle frames, 1 prep frame, and 2 tap frames
+//
+// To change the pixel art, put the raw 128x32 frames in that order in a C
+// file and run lib/oled_anim/oled_anim_convert.py on it to generate the arrays below.
+// clang-format off
+static const uint8_t PROGMEM bongocat_data[] = {
+    0x05, 0x88, 0xe0, 0xce, 0x9c, 0xf8, 0xfc, 0xfe, 0x80, 0xe0, 0x20, 0x19, 0x8d, 0x80, 0x80, 0xc0,
+    0xc0, 0xe0, 0xe0, 0xf0, 0xf8, 0xfc, 0xfe, 0xff, 0xfe, 0xfc, 0xf8, 0xc4, 0xe0, 0xc2, 0xc0, 0x81,
+    0x80, 0x80, 0x3e, 0xc3, 0x01, 0x82, 0x02, 0x02, 0x38, 0xc5, 0xf7, 0x80, 0x31, 0x00, 0x80, 0x08,
+    0xc3, 0x10, 0xc3, 0x20, 0xc3, 0x40, 0xc3, 0x80, 0x87, 0xc0, 0xe0, 0xf0, 0xf8, 0xf8, 0xfc, 0xfc,
+    0xfe, 0xc4, 0xff, 0x8a, 0xcf, 0xcf, 0xff, 0xff, 0xbf, 0x7f, 0x7f, 0xbf, 0xff, 0xff, 0x7f, 0xc8,
+    0xff, 0x81, 0xfe, 0xfe, 0xc3, 0xfc, 0x81, 0xfe, 0xfe, 0xc2, 0xff, 0x80, 0x3f, 0x39, 0x81, 0x03,
+    0x07, 0xc2, 0x0f, 0x80, 0x01, 0x07, 0x89, 0x80, 0xc0, 0xe0, 0x30, 0x38, 0x2c, 0x04, 0x64, 0xf8,
+    0xfe, 0xc4, 0xff, 0x82, 0x7f, 0xbf, 0x8f, 0xc2, 0x27, 0x8d, 0xc7, 0xc7, 0x4f, 0x4f, 0x8f, 0x8f,
+    0x9f, 0x9f, 0x1f, 0x1f, 0x3f, 0x3e, 0x3e, 0x3f, 0xc3, 0x7f, 0x81, 0xfc, 0xfc, 0xcc, 0xff, 0x82,
+    0xfe, 0xf8, 0xe0, 0x35, 0x85, 0x80, 0xc0, 0x60, 0x30, 0x10, 0x18, 0xc2, 0x08, 0xb0, 0x18, 0x10,
+    0x30, 0x60, 0x40, 0xc0, 0x86, 0x87, 0x85, 0xc4, 0x49, 0x69, 0x3e, 0x0e, 0x13, 0x11, 0x12, 0x12,
+    0x3d, 0x2d, 0x25, 0x26, 0x44, 0x68, 0x78, 0x58, 0x9d, 0x97, 0x93, 0xe3, 0x62, 0x34, 0x3c, 0x2c,
+    0x26, 0xc7, 0xc5, 0x69, 0x39, 0x19, 0x1d, 0x36, 0xa2, 0xe2, 0x62, 0x24, 0x18, 0x3c, 0x7e, 0xc2,
+    0x7f, 0x8e, 0xbf, 0x3f, 0x1f, 0x1f, 0x8f, 0xe7, 0x63, 0x27, 0x27, 0x47, 0x47, 0xcf, 0xcf, 0x0f,
+    0x08, 0xc3, 0x10, 0xc3, 0x20, 0xc3, 0x40, 0xc3, 0x80, 0x1f, 0x7f, 0x7f, 0x7f, 0x7f, 0x28, 0x84,
+    0x80, 0x80, 0x40, 0x40, 0x20, 0x08, 0x80, 0x10, 0x00, 0xc2, 0x20, 0x84, 0x40, 0x40, 0xc0, 0x80,
+    0x80, 0x60, 0x87, 0x10, 0x08, 0x08, 0x04, 0x04, 0x02, 0x03, 0x01, 0x02, 0x81, 0x50, 0x50, 0x01,
+    0x83, 0xc0, 0x80, 0x80, 0xc0, 0x01, 0x80, 0x80, 0x79, 0x81, 0x01, 0x01, 0x00, 0x82, 0x03, 0x03,
+    0x01, 0x03, 0x81, 0x05, 0x05, 0x0c, 0x82, 0x02, 0x08, 0x20, 0x7f, 0x31, 0x28, 0x8d, 0x80, 0x80,
+    0xc0, 0x40, 0x60, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08, 0x00, 0x88, 0x20, 0x20,
+    0x60, 0x60, 0x40, 0x40, 0xc0, 0x80, 0x80, 0x60, 0x87, 0x10, 0x08, 0x08, 0x04, 0x04, 0x02, 0x03,
+    0x01, 0x02, 0x81, 0x50, 0x50, 0x01, 0x83, 0xc0, 0x80, 0x80, 0xc0, 0x01, 0x80, 0x80, 0x07, 0x82,
+    0x01, 0x02, 0x02, 0xc3, 0x04, 0x81, 0x02, 0x02, 0xc2, 0x01, 0x80, 0x41, 0x64, 0x81, 0x01, 0x01,
+    0x00, 0x82, 0x03, 0x03, 0x01, 0x03, 0x81, 0x05, 0x05, 0x0c, 0x82, 0x02, 0x08, 0x20, 0x7f, 0x31,
+    0x28, 0x8d, 0x80, 0x80, 0xc0, 0x40, 0x60, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08,
+    0x00, 0x88, 0x20, 0x20, 0x60, 0x60, 0x40, 0x40, 0xc0, 0x80, 0x80, 0x65, 0x82, 0x02, 0x01, 0x01,
+    0x15, 0x82, 0x01, 0x02, 0x02, 0xc3, 0x04, 0x81, 0x06, 0x02, 0xc3, 0x03, 0x80, 0x1c, 0x7f, 0x7f,
+    0x31, 0x7f, 0x44, 0x81, 0x02, 0x02, 0x00, 0x80, 0x01, 0x03, 0x81, 0x0f, 0x06, 0x7f, 0x7f, 0x30,
+    0x2f, 0x86, 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08, 0x01, 0x87, 0x20, 0x20, 0x60, 0x40, 0x40,
+    0xc0, 0x80, 0x80, 0x5c, 0x88, 0x70, 0x78, 0x1c, 0xd6, 0xce, 0x16, 0x04, 0x1c, 0x60, 0x19, 0x80,
+    0x80, 0xc2, 0x40, 0x80, 0x80, 0x54, 0x8c, 0x40, 0xa0, 0x3c, 0x96, 0x87, 0xa6, 0x76, 0x6e, 0x6e,
+    0xac, 0x4c, 0x2c, 0x04, 0x16, 0x81, 0x7e, 0x05, 0x00, 0x82, 0x19, 0x18, 0x02, 0x00, 0x81, 0x03,
+    0x0c, 0x54, 0x80, 0x01, 0x00, 0x84, 0x01, 0x01, 0x03, 0x01, 0x01, 0x15, 0x8c, 0x10, 0x24, 0x10,
+    0x3a, 0xb7, 0xb7, 0x96, 0x06, 0x2e, 0x0e, 0x0c, 0x1c, 0x04, 0x38, 0x2f, 0x86, 0x08, 0x04, 0x02,
+    0x01, 0x02, 0x04, 0x08, 0x01, 0x87, 0x20, 0x20, 0x60, 0x40, 0x40, 0xc0, 0x80, 0x80, 0x5c, 0x88,
+    0x70, 0x78, 0x1c, 0xd6, 0xce, 0x16, 0x04, 0x1c, 0x60, 0x29, 0x81, 0x80, 0x80, 0x47, 0x8c, 0x40,
+    0xa0, 0x3c, 0x96, 0x87, 0xa6, 0x76, 0x6e, 0x6e, 0xac, 0x4c, 0x2c, 0x04, 0x27, 0x87, 0x3f, 0x1f,
+    0x07, 0x83, 0xc0, 0xe0, 0xe0, 0xc0, 0x44, 0x80, 0x01, 0x00, 0x84, 0x01, 0x01, 0x03, 0x01, 0x01,
+    0x2d, 0xc2, 0x01, 0x82, 0x03, 0x03, 0x01, 0x27, 0x2f, 0x86, 0x08, 0x04, 0x02, 0x01, 0x02, 0x04,
+    0x08, 0x01, 0x87, 0x20, 0x20, 0x60, 0x40, 0x40, 0xc0, 0x80, 0x80, 0x52, 0x81, 0x80, 0x80, 0x02,
+    0x85, 0x06, 0x0f, 0x1f, 0x1f, 0x1c, 0x10, 0x21, 0x80, 0x80, 0xc2, 0x40, 0x80, 0x80, 0x4c, 0x85,
+    0x07, 0x0f, 0x0f, 0x07, 0x03, 0x01, 0x25, 0x81, 0x7e, 0x05, 0x00, 0x82, 0x19, 0x18, 0x02, 0x00,
+    0x81, 0x03, 0x0c, 0x71, 0x8c, 0x10, 0x24, 0x10, 0x3a, 0xb7, 0xb7, 0x96, 0x06, 0x2e, 0x0e, 0x0c,
+    0x1c, 0x04, 0x38,
+};
+
+static const uint16_t PROGMEM bongocat_offsets[] = {
+    0, 234, 238, 300, 384, 433, 448, 539, 616,
+};
+// clang-format on
+
+static const oled_anim_t bongocat = {
+    .data    = bongocat_data,
+    .offsets = bongocat_offsets,
+    .size    = ANIM_SIZE,
+};
+
+// assumes 1 frame prep stage
+static void animation_phase(void) {
+    if (get_current_wpm() <= IDLE_SPEED) {
+        current_idle_frame = (current_idle_frame + 1) % IDLE_FRAMES;
+        oled_anim_render(&bongocat, IDLE_FRAME((IDLE_FRAMES - 1) - current_idle_frame));
+    }
+
+    if (get_current_wpm() > IDLE_SPEED && get_current_wpm() < ANIM_WPM_LOWER) {
+        oled_anim_render(&bongocat, PREP_FRAME);
+    }
+
+    if (get_current_wpm() >= ANIM_WPM_LOWER) {
+        current_tap_frame = (current_tap_frame + 1) % TAP_FRAMES;
+        oled_anim_render(&bongocat, TAP_FRAME((TAP_FRAMES - 1) - current_tap_frame));
+    }
+}
+
+void render_bongocat(void) {
+    // variable animation duration. Don't want this value to get near zero as it'll bug out.
+    curr_anim_duration = MAX(ANIM_FRAME_DURATION_MIN, ANIM_FRAME_DURATION_MAX - ANIM_FRAME_RATIO * get_current_wpm());
+
+    if (get_current_wpm() > ANIM_WPM_LOWER) {
+        oled_on();  // not essential but turns on animation OLED with any alpha keypress
+
+        if (timer_elapsed32(bongo_timer) > curr_anim_duration) {
+            bongo_timer = timer_read32();
+            animation_phase();
+        }
+
+        bongo_sleep = timer_read32();
+    } else {
+        if (timer_elapsed32(bongo_sleep) > OLED_TIMEOUT) {
+            oled_off();
+        } else {
+            if (timer_elapsed32(bongo_timer) > IDLE_FRAME_DURATION) {
+                bongo_timer = timer_read32();
+                animation_phase();
+            }
+        }
+    }
+}
@@ -0,0 +1,352 @@
+/* Copyright 2020 sekigon-gonnoc
+ * Copyright 2023 Viktus Design LLC
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ec.h"
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#include "analog.h"
+#include "atomic_util.h"
+#include "eeconfig.h"
+#include "gpio.h"
+#include "print.h"
+#include "util.h"
+
+#if !defined(__AVR__)
+#    error "The EC scanner drives the AVR ADC directly"
+#endif
+
+#ifdef MATRIX_COL_CHANNELS
+// rows are driven, columns are multiplexer channels
+#    define EC_DRIVE_PINS MATRIX_ROW_PINS
+#    define EC_SENSE_CHANNELS MATRIX_COL_CHANNELS
+#    define KEY_ROW(sense, drive) (drive)
+#    define KEY_COL(sense, drive) (sense)
+#else
+// columns are driven, rows are multiplexer channels
+#    define EC_DRIVE_PINS MATRIX_COL_PINS
+#    define EC_SENSE_CHANNELS MATRIX_ROW_PINS
+#    define KEY_ROW(sense, drive) (sense)
+#    define KEY_COL(sense, drive) (drive)
+
+// sensing channel definitions
+#    define A0 0
+#    define A1 1
+#    define A2 2
+#    define A3 3
+#    define A4 4
+#    define A5 5
+#    define A6 6
+#    define A7 7
+#endif
+
+#ifdef SPLIT_KEYBOARD
+#    define EC_ROWS (MATRIX_ROWS / 2)
+#else
+#    define EC_ROWS MATRIX_ROWS
+#endif
+
+// ADC clock, F_CPU / 128 keeps the full 10 bit resolution at 16MHz
+#ifndef EC_ADC_PRESCALER
+#    define EC_ADC_PRESCALER (_BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0))
+#endif
+
+// smallest gap kept between the reset and actuation points
+#ifndef EC_MIN_HYSTERESIS
+#    define EC_MIN_HYSTERESIS 3
+#endif
+
+// calibration: full scans sampled at rest, and the margin kept above it
+#ifndef EC_CALIBRATION_FRAMES
+#    define EC_CALIBRATION_FRAMES 16
+#endif
+#ifndef EC_CALIBRATION_MARGIN
+#    define EC_CALIBRATION_MARGIN 5
+#endif
+
+// pin connections
+static const pin_t   drive_pins[]     = EC_DRIVE_PINS;
+static const uint8_t sense_channels[] = EC_SENSE_CHANNELS;
+static const pin_t   mux_sel_pins[]   = MUX_SEL_PINS;
+
+_Static_assert(ARRAY_SIZE(mux_sel_pins) == 3, "invalid MUX_SEL_PINS");
+_Static_assert(ARRAY_SIZE(drive_pins) * ARRAY_SIZE(sense_channels) == EC_ROWS * MATRIX_COLS, "EC pins don't match the matrix size");
+
+static ec_threshold_t thresholds[EC_ROWS][MATRIX_COLS];
+static ec_threshold_t board_defaults;
+
+#if (EECONFIG_KB_DATA_SIZE) > 0
+_Static_assert(sizeof(thresholds) == (EECONFIG_KB_DATA_SIZE), "EECONFIG_KB_DATA_SIZE must match the threshold table");
+#endif
+
+// written from the ADC interrupt
+static volatile uint16_t     sw_value[EC_ROWS][MATRIX_COLS];
+static volatile matrix_row_t ec_matrix[EC_ROWS];
+static volatile uint8_t      frame_count;
+static volatile bool         calibrating;
+
+// key being converted
+static uint8_t sense, drive;
+static uint8_t adc_control = _BV(ADEN) | EC_ADC_PRESCALER;
+
+static inline void discharge_capacitor(void) { gpio_set_pin_output(DISCHARGE_PIN); }
+static inline void charge_capacitor(uint8_t drive) {
+    gpio_set_pin_input(DISCHARGE_PIN);
+    gpio_write_pin_high(drive_pins[drive]);
+}
+
+static inline void select_mux(uint8_t sense) {
+    uint8_t ch = sense_channels[sense];
+    gpio_write_pin(mux_sel_pins[0], ch & 1);
+    gpio_write_pin(mux_sel_pins[1], ch & 2);
+    gpio_write_pin(mux_sel_pins[2], ch & 4);
+}
+
+static inline void update_key(uint8_t row, uint8_t col, uint16_t value) {
+    matrix_row_t mask = MATRIX_ROW_SHIFTER << col;
+
+    if (ec_matrix[row] & mask) {
+        // press to release
+        if (value < thresholds[row][col].reset_pt) ec_matrix[row] &= ~mask;
+    } else {
+        // release to press
+        if (value > thresholds[row][col].actuation_pt) ec_matrix[row] |= mask;
+    }
+}
+
+// Start a conversion of the key just charged. Toggling ADEN makes it an
+// extended first conversion, which holds the sample 13.5 ADC clocks after the
+// start rather than 1.5. That is the charge time analogReadPin() gave, and
+// the board thresholds were tuned against it.
+static inline void start_conversion(void) {
+    ADCSRA = 0;
+    ADCSRA = adc_control | _BV(ADSC);
+}
+
+// Collect the finished conversion and charge the next key. The sample was held
+// long before this runs, so the capacitor is free; discharging first lets the
+// bookkeeping double as discharge time.
+static inline void ec_step(void) {
+    discharge_capacitor();
+    gpio_write_pin_low(drive_pins[drive]);
+
+    uint16_t value = ADC;
+    uint8_t  row   = KEY_ROW(sense, drive);
+    uint8_t  col   = KEY_COL(sense, drive);
+
+    if (calibrating) {
+        if (value > sw_value[row][col]) sw_value[row][col] = value;
+    } else {
+        sw_value[row][col] = value;
+        update_key(row, col, value);
+    }
+
+    if (++drive == ARRAY_SIZE(drive_pins)) {
+        drive = 0;
+        if (++sense == ARRAY_SIZE(sense_channels)) {
+            sense = 0;
+            frame_count++;
+        }
+        select_mux(sense);
+    }
+
+    charge_capacitor(drive);
+    start_conversion();
+}
+
+ISR(ADC_vect) { ec_step(); }
+
+__attribute__((weak)) void ec_threshold_kb(uint8_t row, uint8_t col, ec_threshold_t* threshold) {}
+
+static ec_threshold_t default_threshold(uint8_t row, uint8_t col) {
+    ec_threshold_t threshold = board_defaults;
+    ec_threshold_kb(row, col, &threshold);
+    return threshold;
+}
+
+static void set_threshold(uint8_t row, uint8_t col, ec_threshold_t threshold) {
+    if (threshold.actuation_pt < threshold.reset_pt + EC_MIN_HYSTERESIS) {
+        threshold.actuation_pt = threshold.reset_pt + EC_MIN_HYSTERESIS;
+    }
+    ATOMIC_BLOCK_FORCEON {
+        thresholds[row][col] = threshold;
+    }
+}
+
+static void save_thresholds(void) {
+#if (EECONFIG_KB_DATA_SIZE) > 0
+    eeconfig_update_kb_datablock(thresholds);
+#endif
+}
+
+static void load_thresholds(void) {
+#if (EECONFIG_KB_DATA_SIZE) > 0
+    eeconfig_read_kb_datablock(thresholds);
+#endif
+    for (uint8_t row = 0; row < EC_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            // a cleared entry has never been calibrated
+            ec_threshold_t threshold = thresholds[row][col];
+            if (threshold.actuation_pt == 0) threshold = default_threshold(row, col);
+            set_threshold(row, col, threshold);
+        }
+    }
+}
+
+void ec_init(ec_threshold_t const* const defaults) {
+    board_defaults = *defaults;
+    load_thresholds();
+
+    // initialize discharge pin as discharge mode
+    gpio_write_pin_low(DISCHARGE_PIN);
+    gpio_set_pin_output(DISCHARGE_PIN);
+
+    // initialize drive lines
+    for (uint8_t idx = 0; idx < ARRAY_SIZE(drive_pins); idx++) {
+        gpio_set_pin_output(drive_pins[idx]);
+        gpio_write_pin_low(drive_pins[idx]);
+    }
+
+    // initialize multiplexer select pins
+    for (uint8_t idx = 0; idx < ARRAY_SIZE(mux_sel_pins); idx++) {
+        gpio_set_pin_output(mux_sel_pins[idx]);
+    }
+
+    // keep the ADC on the analog pin, the first conversion after enabling is
+    // a slow one and is thrown away
+    uint8_t mux = pinToMux(ANALOG_PORT);
+    ADCSRB      = (mux & 0x20) ? _BV(MUX5) : 0;
+    ADMUX       = ADC_REF_POWER | (mux & 0x1F);
+    ADCSRA      = adc_control | _BV(ADSC);
+    while (ADCSRA & _BV(ADSC)) {
+    }
+    ADCSRA = adc_control | _BV(ADIF);
+
+    // start on the first key
+    select_mux(0);
+    ATOMIC_BLOCK_FORCEON {
+        charge_capacitor(0);
+        start_conversion();
+    }
+
+    // scan the first frame in place so the matrix is valid for bootmagic
+    uint8_t frame = frame_count;
+    while (frame_count == frame) {
+        while (!(ADCSRA & _BV(ADIF))) {
+        }
+        ADCSRA = adc_control | _BV(ADIF);
+        ATOMIC_BLOCK_FORCEON {
+            ec_step();
+        }
+    }
+
+    // and leave the rest to the interrupt, writing 0 to ADSC and ADIF is a
+    // no-op so the conversion in flight is kept
+    adc_control |= _BV(ADIE);
+    ADCSRA = adc_control;
+}
+
+uint16_t ec_readkey_raw(uint8_t row, uint8_t col) {
+    uint16_t value;
+    ATOMIC_BLOCK_FORCEON {
+        value = sw_value[row][col];
+    }
+    return value;
+}
+
+bool ec_matrix_scan(matrix_row_t current_matrix[]) {
+    bool updated = false;
+
+    for (uint8_t row = 0; row < EC_ROWS; row++) {
+        matrix_row_t value;
+        ATOMIC_BLOCK_FORCEON {
+            value = ec_matrix[row];
+        }
+        if (current_matrix[row] != value) {
+            current_matrix[row] = value;
+            updated             = true;
+        }
+    }
+
+    return updated;
+}
+
+void ec_calibrate(void) {
+    ATOMIC_BLOCK_FORCEON {
+        for (uint8_t row = 0; row < EC_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                sw_value[row][col] = 0;
+            }
+        }
+        calibrating = true;
+    }
+
+    // the interrupt keeps the highest value seen, the first frame is partial
+    uint8_t start = frame_count;
+    while ((uint8_t)(frame_count - start) <= EC_CALIBRATION_FRAMES) {
+    }
+
+    for (uint8_t row = 0; row < EC_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint16_t       rest      = ec_readkey_raw(row, col) + EC_CALIBRATION_MARGIN;
+            ec_threshold_t threshold = thresholds[row][col];
+            if (threshold.reset_pt < rest) {
+                threshold.reset_pt = rest;
+                set_threshold(row, col, threshold);
+            }
+        }
+    }
+    calibrating = false;
+
+    save_thresholds();
+}
+
+void ec_reset_calibration(void) {
+    for (uint8_t row = 0; row < EC_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            set_threshold(row, col, default_threshold(row, col));
+        }
+    }
+
+    save_thresholds();
+}
+
+bool process_record_ec(uint16_t keycode, keyrecord_t* record) {
+    switch (keycode) {
+        // on release, so the calibration key itself is up
+        case EC_CALIBRATE:
+            if (!record->event.pressed) {
+                ec_calibrate();
+            }
+            return false;
+        case EC_CALIBRATE_RESET:
+            if (!record->event.pressed) {
+                ec_reset_calibration();
+            }
+            return false;
+    }
+    return true;
+}
+
+// console debugging for pad values
+void ec_print_matrix(void) {
+    for (uint8_t row = 0; row < EC_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            xprintf("%5d", ec_readkey_raw(row, col));
+        }
+        xprintf("\n");
+    }
+}
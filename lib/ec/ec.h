@@ -0,0 +1,71 @@
+/* Copyright 2020 sekigon-gonnoc
+ * Copyright 2023 Viktus Design LLC
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// Scan a Topre/EC switch matrix through a 74HC4051 style multiplexer
+//
+// The board describes its wiring in config.h:
+//   DISCHARGE_PIN  pin shorting the peak hold capacitor
+//   ANALOG_PORT    ADC pin reading the peak hold capacitor
+//   MUX_SEL_PINS   three multiplexer select pins
+// and either
+//   MATRIX_COL_PINS driven, MATRIX_ROW_PINS as multiplexer channels (A0-A7)
+// or
+//   MATRIX_ROW_PINS driven, MATRIX_COL_CHANNELS as multiplexer channels
+//
+// Keys are sampled in the background from the ADC interrupt, one key per
+// conversion, and ec_matrix_scan() only copies out the result.
+//
+// Per-key thresholds start from the defaults passed to ec_init(), adjusted by
+// ec_threshold_kb(). With EECONFIG_KB_DATA_SIZE set to the size of the
+// threshold table, ec_calibrate() results are kept in EEPROM. Boards pass
+// their records to process_record_ec() to get the calibration keycodes.
+//
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "matrix.h"
+#include "action.h"
+#include "keycodes.h"
+
+enum ec_keycodes {
+    EC_CALIBRATE = QK_KB_0, // calibrate on release, keep the other keys up
+    EC_CALIBRATE_RESET,     // back to the board thresholds
+};
+
+typedef struct {
+    uint16_t reset_pt;     // release below this value
+    uint16_t actuation_pt; // press above this value
+} ec_threshold_t;
+
+void     ec_init(ec_threshold_t const* const defaults);
+bool     ec_matrix_scan(matrix_row_t current_matrix[]);
+void     ec_print_matrix(void);
+uint16_t ec_readkey_raw(uint8_t row, uint8_t col);
+
+// Raise reset points above the measured rest level, all keys must be released
+void ec_calibrate(void);
+// Go back to the board thresholds
+void ec_reset_calibration(void);
+// Handle the keycodes above, false if the record was consumed
+bool process_record_ec(uint16_t keycode, keyrecord_t* record);
+
+// Board specific threshold for (row, col), called once per key at init
+void ec_threshold_kb(uint8_t row, uint8_t col, ec_threshold_t* threshold);
@@ -8,6 +8,8 @@
 typedef uint8_t     port_data_t;
 
 #define readPort(port)                 PINx_ADDRESS(port)
+#define portId(pin)                    ((pin) >> PORT_SHIFTER)
+#define portBit(pin)                   ((pin) & 0xF)
 
 #define setPortBitInput(port, bit)     (DDRx_ADDRESS(port) &= ~_BV((bit)&0xF), PORTx_ADDRESS(port) &= ~_BV((bit)&0xF))
 #define setPortBitInputHigh(port, bit) (DDRx_ADDRESS(port) &= ~_BV((bit)&0xF), PORTx_ADDRESS(port) |= _BV((bit)&0xF))
@@ -17,9 +19,12 @@ typedef uint8_t     port_data_t;
 #define writePortBitHigh(port, bit)    (PORTx_ADDRESS(port) |= _BV((bit)&0xF))
 
 #else
-typedef uint16_t     port_data_t;
+// ports are up to 32 bits wide, e.g. GP16-GP29 on the RP2040
+typedef ioportmask_t port_data_t;
 
 #define readPort(qmk_pin)                 palReadPort(PAL_PORT(qmk_pin))
+#define portId(qmk_pin)                   ((uintptr_t)PAL_PORT(qmk_pin))
+#define portBit(qmk_pin)                  PAL_PAD(qmk_pin)
 
 #define setPortBitInput(qmk_pin, bit)     palSetPadMode(PAL_PORT(qmk_pin), bit, PAL_MODE_INPUT)
 #define setPortBitInputHigh(qmk_pin, bit) palSetPadMode(PAL_PORT(qmk_pin), bit, PAL_MODE_INPUT_PULLUP)
@@ -0,0 +1,276 @@
+/*
+Copyright 2021 mtei
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#include "atomic_util.h"
+#include "util.h"
+#include "wait.h"
+#include "matrix.h"
+#include "debounce.h"
+#ifndef readPort
+#    include "gpio_extr.h"
+#endif
+
+#ifndef MATRIX_DEBUG_PIN
+#    define MATRIX_DEBUG_PIN_INIT()
+#    define MATRIX_DEBUG_SCAN_START()
+#    define MATRIX_DEBUG_SCAN_END()
+#    define MATRIX_DEBUG_DELAY_START()
+#    define MATRIX_DEBUG_DELAY_END()
+#    define MATRIX_DEBUG_GAP()
+#else
+#    define MATRIX_DEBUG_GAP() asm volatile("nop \n nop" ::: "memory")
+#endif
+
+/* Upper bound of port reads while waiting for the inputs to go back HIGH */
+#ifndef MATRIX_UNSELECT_WAIT_LIMIT
+#    define MATRIX_UNSELECT_WAIT_LIMIT 255
+#endif
+
+#if defined(DIRECT_PINS)
+#    error matrix_portscan does not support DIRECT_PINS
+#elif (DIODE_DIRECTION == COL2ROW)
+#    define MATRIX_OUTPUTS MATRIX_ROWS
+#    define MATRIX_INPUTS  MATRIX_COLS
+typedef matrix_row_t matrix_line_t;
+#elif (DIODE_DIRECTION == ROW2COL)
+#    define MATRIX_OUTPUTS MATRIX_COLS
+#    define MATRIX_INPUTS  MATRIX_ROWS
+#    if (MATRIX_ROWS <= 8)
+typedef uint8_t matrix_line_t;
+#    elif (MATRIX_ROWS <= 16)
+typedef uint16_t matrix_line_t;
+#    else
+typedef uint32_t matrix_line_t;
+#    endif
+#else
+#    error DIODE_DIRECTION must be one of COL2ROW or ROW2COL!
+#endif
+
+static const pin_t row_pins[MATRIX_ROWS] = MATRIX_ROW_PINS;
+static const pin_t col_pins[MATRIX_COLS] = MATRIX_COL_PINS;
+
+#if (DIODE_DIRECTION == COL2ROW)
+#    define out_pins row_pins
+#    define in_pins  col_pins
+#else
+#    define out_pins col_pins
+#    define in_pins  row_pins
+#endif
+
+/*
+ * The input pins are grouped by GPIO port when the matrix is initialized.
+ * A scan reads every port once and then moves each run of consecutive port
+ * bits that map to consecutive matrix bits with a single shift and mask,
+ * instead of reading the input pins one by one.
+ */
+typedef struct {
+    uint8_t     port;  // index into in_ports[]
+    uint8_t     bit;   // first port bit of the run
+    uint8_t     line;  // first matrix line bit of the run
+    port_data_t mask;  // run mask, after shifting by bit
+} port_run_t;
+
+static pin_t       in_ports[MATRIX_INPUTS];  // any pin of the port, for readPort()
+static port_data_t in_port_masks[MATRIX_INPUTS];
+static uint8_t     in_port_count;
+static port_run_t  in_runs[MATRIX_INPUTS];
+static uint8_t     in_run_count;
+
+/* matrix state(1:on, 0:off) */
+extern matrix_row_t raw_matrix[MATRIX_ROWS];  // raw values
+extern matrix_row_t matrix[MATRIX_ROWS];      // debounced values
+
+static inline void gpio_atomic_set_pin_output_low(pin_t pin) {
+    ATOMIC_BLOCK_FORCEON {
+        gpio_set_pin_output(pin);
+        gpio_write_pin_low(pin);
+    }
+}
+
+static inline void gpio_atomic_set_pin_input_high(pin_t pin) {
+    ATOMIC_BLOCK_FORCEON { gpio_set_pin_input_high(pin); }
+}
+
+static uint8_t find_or_add_port(pin_t pin) {
+    for (uint8_t i = 0; i < in_port_count; i++) {
+        if (portId(in_ports[i]) == portId(pin)) {
+            return i;
+        }
+    }
+    in_ports[in_port_count]      = pin;
+    in_port_masks[in_port_count] = 0;
+    return in_port_count++;
+}
+
+static void init_port_runs(void) {
+    port_run_t *run = NULL;
+
+    in_port_count = 0;
+    in_run_count  = 0;
+    for (uint8_t i = 0; i < MATRIX_INPUTS; i++) {
+        pin_t pin = in_pins[i];
+        if (pin == NO_PIN) {
+            run = NULL;
+            continue;
+        }
+
+        uint8_t port = find_or_add_port(pin);
+        uint8_t bit  = portBit(pin);
+        in_port_masks[port] |= (port_data_t)1 << bit;
+
+        // Extend the current run if this pin is the next bit of the same port
+        if (run && run->port == port && run->bit + (i - run->line) == bit) {
+            run->mask = (run->mask << 1) | 1;
+            continue;
+        }
+
+        run       = &in_runs[in_run_count++];
+        run->port = port;
+        run->bit  = bit;
+        run->line = i;
+        run->mask = 1;
+    }
+}
+
+static void init_pins(void) {
+    for (uint8_t x = 0; x < MATRIX_OUTPUTS; x++) {
+        if (out_pins[x] != NO_PIN) {
+            gpio_atomic_set_pin_input_high(out_pins[x]);
+        }
+    }
+    for (uint8_t x = 0; x < MATRIX_INPUTS; x++) {
+        if (in_pins[x] != NO_PIN) {
+            gpio_atomic_set_pin_input_high(in_pins[x]);
+        }
+    }
+    init_port_runs();
+}
+
+static inline void read_in_ports(port_data_t buffer[]) {
+    for (uint8_t i = 0; i < in_port_count; i++) {
+        buffer[i] = readPort(in_ports[i]);
+    }
+}
+
+static matrix_line_t build_matrix_line(const port_data_t buffer[]) {
+    matrix_line_t line = 0;
+    for (uint8_t i = 0; i < in_run_count; i++) {
+        const port_run_t *run = &in_runs[i];
+        line |= (matrix_line_t)(((port_data_t)~buffer[run->port] >> run->bit) & run->mask) << run->line;
+    }
+    return line;
+}
+
+// Wait until every input reads HIGH again, all ports at once
+static void wait_inputs_high(void) {
+    port_data_t buffer[MATRIX_INPUTS];
+    bool        low;
+    uint8_t     limit = MATRIX_UNSELECT_WAIT_LIMIT;
+
+    do {
+        read_in_ports(buffer);
+        low = false;
+        for (uint8_t i = 0; i < in_port_count; i++) {
+            low |= ((port_data_t)~buffer[i] & in_port_masks[i]) != 0;
+        }
+    } while (low && --limit);
+}
+
+static matrix_line_t read_matrix_line(uint8_t current_line) {
+    port_data_t   buffer[MATRIX_INPUTS];
+    matrix_line_t line;
+
+    if (out_pins[current_line] == NO_PIN) {
+        return 0;
+    }
+
+    // Select row (or col) and read all input ports
+    gpio_atomic_set_pin_output_low(out_pins[current_line]);
+    matrix_output_select_delay();
+    read_in_ports(buffer);
+    gpio_atomic_set_pin_input_high(out_pins[current_line]);
+
+    line = build_matrix_line(buffer);
+
+    // Wait signal raise up
+    if (line) {
+        MATRIX_DEBUG_DELAY_START();
+        wait_inputs_high();
+        MATRIX_DEBUG_DELAY_END();
+    }
+    return line;
+}
+
+void matrix_init(void) {
+    // initialize key pins
+    init_pins();
+
+    // initialize matrix state: all keys off
+    for (uint8_t i = 0; i < MATRIX_ROWS; i++) {
+        raw_matrix[i] = 0;
+        matrix[i]     = 0;
+    }
+
+    debounce_init(MATRIX_ROWS);
+
+    matrix_init_kb();
+}
+
+uint8_t matrix_scan(void) {
+    bool changed = false;
+    MATRIX_DEBUG_PIN_INIT();
+
+    MATRIX_DEBUG_SCAN_START();
+#if (DIODE_DIRECTION == COL2ROW)
+    // Set row, read cols
+    for (uint8_t current_row = 0; current_row < MATRIX_ROWS; current_row++) {
+        matrix_row_t row = read_matrix_line(current_row);
+        if (raw_matrix[current_row] != row) {
+            raw_matrix[current_row] = row;
+            changed                 = true;
+        }
+    }
+#else
+    // Set col, read rows, then transpose
+    matrix_row_t trans_matrix[MATRIX_ROWS] = {0};
+    for (uint8_t current_col = 0; current_col < MATRIX_COLS; current_col++) {
+        matrix_line_t col = read_matrix_line(current_col);
+        for (uint8_t row = 0; col; row++, col >>= 1) {
+            if (col & 1) {
+                trans_matrix[row] |= MATRIX_ROW_SHIFTER << current_col;
+            }
+        }
+    }
+    for (uint8_t current_row = 0; current_row < MATRIX_ROWS; current_row++) {
+        if (raw_matrix[current_row] != trans_matrix[current_row]) {
+            raw_matrix[current_row] = trans_matrix[current_row];
+            changed                 = true;
+        }
+    }
+#endif
+    MATRIX_DEBUG_SCAN_END();
+    MATRIX_DEBUG_GAP();
+
+    MATRIX_DEBUG_SCAN_START();
+    debounce(raw_matrix, matrix, MATRIX_ROWS, changed);
+    MATRIX_DEBUG_SCAN_END();
+    MATRIX_DEBUG_GAP();
+
+    MATRIX_DEBUG_SCAN_START();
+    matrix_scan_kb();
+    MATRIX_DEBUG_SCAN_END();
+    return (uint8_t)changed;
+}
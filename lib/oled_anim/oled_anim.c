@@ -0,0 +1,71 @@
+/* Copyright 2022 HorrorTroll <https://github.com/HorrorTroll>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "oled_anim.h"
+#include "oled_driver.h"
+#include "progmem.h"
+
+typedef struct {
+    const uint8_t *data;
+    uint8_t        op;
+    uint8_t        left;
+    uint8_t        value;
+} anim_reader_t;
+
+static void reader_init(anim_reader_t *reader, const oled_anim_t *anim, uint8_t stream) {
+    reader->data = anim->data + pgm_read_word(&anim->offsets[stream]);
+    reader->left = 0;
+}
+
+// Returns the next byte of the stream
+static uint8_t reader_next(anim_reader_t *reader) {
+    if (reader->left == 0) {
+        reader->op = pgm_read_byte(reader->data++);
+        if (reader->op < 0x80) {
+            reader->left = reader->op + 1;
+        } else {
+            reader->left = (reader->op & 0x3F) + 1;
+            if (reader->op >= 0xC0) {
+                reader->value = pgm_read_byte(reader->data++);
+            }
+        }
+    }
+    reader->left--;
+
+    if (reader->op < 0x80) {
+        return 0;
+    } else if (reader->op < 0xC0) {
+        return pgm_read_byte(reader->data++);
+    }
+    return reader->value;
+}
+
+void oled_anim_render(const oled_anim_t *anim, uint8_t frame) {
+    anim_reader_t base;
+    anim_reader_t delta;
+    uint16_t      size = anim->size;
+
+    if (size > OLED_MATRIX_SIZE) {
+        size = OLED_MATRIX_SIZE;
+    }
+
+    reader_init(&base, anim, 0);
+    reader_init(&delta, anim, frame + 1);
+
+    for (uint16_t i = 0; i < size; i++) {
+        oled_write_raw_byte(reader_next(&base) ^ reader_next(&delta), i);
+    }
+}
@@ -0,0 +1,38 @@
+/* Copyright 2022 HorrorTroll <https://github.com/HorrorTroll>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/* An animation stored as run-length coded streams, see oled_anim_convert.py.
+ *
+ * Stream 0 is the base frame, every other stream is one frame XORed with the
+ * base. Each stream is a sequence of:
+ *
+ *   0x00-0x7F        skip n+1 bytes (no difference)
+ *   0x80-0xBF, ...   n+1 literal bytes follow
+ *   0xC0-0xFF, v     v repeated n+1 times
+ */
+typedef struct {
+    const uint8_t  *data;    // streams, in PROGMEM
+    const uint16_t *offsets; // start of each stream in data, in PROGMEM
+    uint16_t        size;    // bytes per frame, drawn from the top-left of the OLED
+} oled_anim_t;
+
+/* Decode a frame straight into the OLED buffer. Only bytes that differ from
+ * what is in the buffer are written, so only changed blocks get flushed. */
+void oled_anim_render(const oled_anim_t *anim, uint8_t frame);
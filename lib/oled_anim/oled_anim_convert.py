@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""Convert raw OLED animation frames to the oled_anim format
+
+Reads every brace-enclosed list of numbers (one per frame, in order) from a
+C source file, such as the raw PROGMEM arrays in a bongocat.c, and prints
+the streams and offsets used by oled_anim.c.
+
+The first frame is stored as-is and every frame is stored as the XOR against
+it, all run-length coded. The output is decoded again and compared with the
+input before it is printed, so a successful run means the conversion is
+bit-exact.
+
+Usage:
+    python3 oled_anim_convert.py INPUT_PATH NAME [FRAME_SIZE]
+"""
+import re
+import sys
+
+SKIP_MAX = 0x80
+LITERAL_MAX = 0x40
+REPEAT_MAX = 0x40
+
+
+def read_frames(path, size):
+    with open(path) as f:
+        source = f.read()
+
+    # Strip comments so "//Idle 1 - 128x32" isn't read as data
+    source = re.sub(r'//[^\n]*', '', source)
+    source = re.sub(r'/\*.*?\*/', '', source, flags=re.S)
+
+    frames = []
+    for body in re.findall(r'\{([^{}]*)\}', source):
+        # Only plain lists of numbers are frames
+        if not re.fullmatch(r'[\s,0-9a-fA-FxX]*', body):
+            continue
+        values = [int(v, 0) for v in re.findall(r'0x[0-9a-fA-F]+|\d+', body)]
+        if len(values) < 2:
+            continue
+        frame = (values + [0] * size)[:size]
+        frames.append(frame)
+    return frames
+
+
+def encode(stream):
+    out = []
+    i = 0
+    while i < len(stream):
+        # Unchanged bytes
+        run = 0
+        while i + run < len(stream) and stream[i + run] == 0 and run < SKIP_MAX:
+            run += 1
+        if run:
+            out.append(run - 1)
+            i += run
+            continue
+
+        # Repeated byte
+        run = 1
+        while i + run < len(stream) and stream[i + run] == stream[i] and run < REPEAT_MAX:
+            run += 1
+        if run >= 3:
+            out += [0xC0 | (run - 1), stream[i]]
+            i += run
+            continue
+
+        # Literal bytes, up to the next skip or repeat
+        start = i
+        while i < len(stream) and i - start < LITERAL_MAX:
+            if stream[i] == 0:
+                break
+            if i + 2 < len(stream) and stream[i] == stream[i + 1] == stream[i + 2]:
+                break
+            i += 1
+        out += [0x80 | (i - start - 1)] + stream[start:i]
+    return out
+
+
+def decode(data, size):
+    out = []
+    pos = 0
+    while len(out) < size:
+        op = data[pos]
+        pos += 1
+        if op < 0x80:
+            out += [0] * (op + 1)
+        elif op < 0xC0:
+            count = (op & 0x3F) + 1
+            out += data[pos:pos + count]
+            pos += count
+        else:
+            out += [data[pos]] * ((op & 0x3F) + 1)
+            pos += 1
+    return out, pos
+
+
+def main():
+    if len(sys.argv) < 3:
+        print(__doc__.strip(), file=sys.stderr)
+        sys.exit(1)
+
+    path, name = sys.argv[1], sys.argv[2]
+    size = int(sys.argv[3]) if len(sys.argv) > 3 else 512
+
+    frames = read_frames(path, size)
+    if not frames:
+        sys.exit('No frames found in %s' % path)
+
+    base = frames[0]
+    streams = [encode(base)] + [encode([a ^ b for a, b in zip(frame, base)]) for frame in frames]
+
+    # Verify the round trip before emitting anything
+    decoded_base, _ = decode(streams[0], size)
+    for index, frame in enumerate(frames):
+        delta, used = decode(streams[index + 1], size)
+        if [a ^ b for a, b in zip(decoded_base, delta)] != frame or used != len(streams[index + 1]):
+            sys.exit('Frame %d does not round trip' % index)
+
+    offsets = [0]
+    for stream in streams:
+        offsets.append(offsets[-1] + len(stream))
+    data = [byte for stream in streams for byte in stream]
+
+    print('// Generated by oled_anim_convert.py: %d frames, %d bytes (%d raw)' % (len(frames), len(data), len(frames) * size))
+    print('static const uint8_t PROGMEM %s_data[] = {' % name)
+    for i in range(0, len(data), 16):
+        print('    ' + ', '.join('0x%02x' % b for b in data[i:i + 16]) + ',')
+    print('};')
+    print('')
+    print('static const uint16_t PROGMEM %s_offsets[] = {' % name)
+    print('    ' + ', '.join(str(o) for o in offsets[:-1]) + ',')
+    print('};')
+
+
+if __name__ == '__main__':
+    main()
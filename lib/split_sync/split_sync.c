@@ -0,0 +1,163 @@
+// Copyright 2018-2023 Nick Brassel (@tzarc)
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <string.h>
+#include "quantum.h"
+#include "transactions.h"
+#include "split_util.h"
+#include "split_sync.h"
+
+enum {
+    SPLIT_SYNC_DATA,      // block, version, data -> version, status
+    SPLIT_SYNC_HEARTBEAT, // nothing -> version of every block
+};
+
+enum {
+    SPLIT_SYNC_OK,
+    SPLIT_SYNC_MISMATCH, // the slave's firmware has no such block or another size
+};
+
+#define SPLIT_SYNC_HEADER_SIZE 3
+
+static int8_t              sync_transaction_id;
+static split_sync_block_t* sync_blocks;
+static uint8_t             sync_count;
+
+__attribute__((weak)) void split_sync_received_kb(uint8_t block) {}
+
+static void split_sync_slave_handler(uint8_t m2s_size, const void* m2s_buffer, uint8_t s2m_size, void* s2m_buffer) {
+    const uint8_t* m2s = (const uint8_t*)m2s_buffer;
+    uint8_t*       s2m = (uint8_t*)s2m_buffer;
+
+    if (m2s_size < 1) return;
+
+    switch (m2s[0]) {
+        case SPLIT_SYNC_DATA: {
+            if (m2s_size < SPLIT_SYNC_HEADER_SIZE || s2m_size < 2) return;
+            if (m2s[1] >= sync_count || m2s_size != SPLIT_SYNC_HEADER_SIZE + sync_blocks[m2s[1]].size) {
+                s2m[0] = 0;
+                s2m[1] = SPLIT_SYNC_MISMATCH;
+                return;
+            }
+            split_sync_block_t* block = &sync_blocks[m2s[1]];
+            memcpy(block->data, &m2s[SPLIT_SYNC_HEADER_SIZE], block->size);
+            block->version = m2s[2];
+            split_sync_received_kb(m2s[1]);
+            s2m[0] = block->version;
+            s2m[1] = SPLIT_SYNC_OK;
+            break;
+        }
+        case SPLIT_SYNC_HEARTBEAT:
+            for (uint8_t i = 0; i < sync_count && i < s2m_size; i++) {
+                s2m[i] = sync_blocks[i].version;
+            }
+            break;
+    }
+}
+
+void split_sync_init(int8_t transaction_id, split_sync_block_t* blocks, uint8_t count) {
+    sync_transaction_id = transaction_id;
+    sync_blocks         = blocks;
+    sync_count          = count;
+
+    // Version 0 is what a fresh slave holds, so the master starts at 1 and
+    // everything goes out once after boot. A slave that reboots reports 0
+    // again in the next heartbeat and gets every block resent.
+    bool master = is_keyboard_master();
+    for (uint8_t i = 0; i < count; i++) {
+        memcpy(blocks[i].shadow, blocks[i].data, blocks[i].size);
+        blocks[i].version = master ? 1 : 0;
+        blocks[i].acked    = 0;
+        blocks[i].rejected = 0;
+    }
+
+    transaction_register_rpc(transaction_id, split_sync_slave_handler);
+}
+
+static bool split_sync_send_block(uint8_t index) {
+    split_sync_block_t* block = &sync_blocks[index];
+    uint8_t             m2s[RPC_M2S_BUFFER_SIZE];
+    uint8_t             s2m[2];
+
+    if (SPLIT_SYNC_HEADER_SIZE + block->size > sizeof(m2s)) {
+        dprintf("split_sync: block %u does not fit in RPC_M2S_BUFFER_SIZE\n", index);
+        block->acked = block->version;
+        return true;
+    }
+
+    m2s[0] = SPLIT_SYNC_DATA;
+    m2s[1] = index;
+    m2s[2] = block->version;
+    memcpy(&m2s[SPLIT_SYNC_HEADER_SIZE], block->shadow, block->size);
+
+    if (!transaction_rpc_exec(sync_transaction_id, SPLIT_SYNC_HEADER_SIZE + block->size, m2s, sizeof(s2m), s2m)) {
+        dprint("split_sync: failed to send block\n");
+        return false;
+    }
+
+    // Mixed firmware on the two halves, resending won't help until the
+    // block changes again
+    if (s2m[1] == SPLIT_SYNC_MISMATCH) {
+        dprintf("split_sync: slave rejected block %u\n", index);
+        block->rejected = block->version;
+        return true;
+    }
+
+    block->acked = s2m[0];
+    return s2m[0] == block->version;
+}
+
+static bool split_sync_heartbeat(void) {
+    uint8_t versions[RPC_S2M_BUFFER_SIZE];
+    uint8_t request = SPLIT_SYNC_HEARTBEAT;
+    uint8_t count   = MIN(sync_count, sizeof(versions));
+
+    if (!transaction_rpc_exec(sync_transaction_id, sizeof(request), &request, count, versions)) {
+        return false;
+    }
+
+    // Anything the slave doesn't hold goes out again
+    for (uint8_t i = 0; i < count; i++) {
+        sync_blocks[i].acked = versions[i];
+    }
+    return true;
+}
+
+void split_sync_task(void) {
+    static uint32_t last_heartbeat = 0;
+    static uint32_t last_failure   = 0;
+    static bool     failed         = false;
+
+    if (!is_keyboard_master() || !is_transport_connected() || sync_count == 0) return;
+
+    // Bump the version of anything that changed since it was last seen
+    for (uint8_t i = 0; i < sync_count; i++) {
+        split_sync_block_t* block = &sync_blocks[i];
+        if (memcmp(block->data, block->shadow, block->size)) {
+            memcpy(block->shadow, block->data, block->size);
+            if (++block->version == 0) block->version = 1;
+        }
+    }
+
+    // Don't hammer the link while transactions are failing
+    if (failed && timer_elapsed32(last_failure) < SPLIT_SYNC_RETRY_INTERVAL) return;
+    failed = false;
+
+    if (timer_elapsed32(last_heartbeat) >= SPLIT_SYNC_HEARTBEAT_INTERVAL) {
+        if (split_sync_heartbeat()) {
+            last_heartbeat = timer_read32();
+        } else {
+            failed       = true;
+            last_failure = timer_read32();
+            return;
+        }
+    }
+
+    for (uint8_t i = 0; i < sync_count; i++) {
+        split_sync_block_t* block = &sync_blocks[i];
+        if (block->acked != block->version && block->rejected != block->version && !split_sync_send_block(i)) {
+            failed       = true;
+            last_failure = timer_read32();
+            return;
+        }
+    }
+}
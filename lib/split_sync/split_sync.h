@@ -0,0 +1,44 @@
+// Copyright 2018-2023 Nick Brassel (@tzarc)
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+
+//----------------------------------------------------------
+// Versioned master -> slave state sync
+//
+// Each block is a struct owned by the master and mirrored on the slave. The
+// master bumps a block's version whenever its contents change and sends it
+// until the slave acknowledges that version. A periodic heartbeat only carries
+// the slave's versions back, so a slave that reset gets its blocks again. A
+// slave built with another block layout refuses the block, and that version
+// is not sent again.
+//
+// All blocks share one split transaction ID, which the board lists in
+// SPLIT_TRANSACTION_IDS_KB and passes to split_sync_init().
+
+#ifndef SPLIT_SYNC_HEARTBEAT_INTERVAL
+#    define SPLIT_SYNC_HEARTBEAT_INTERVAL 500
+#endif
+
+#ifndef SPLIT_SYNC_RETRY_INTERVAL
+#    define SPLIT_SYNC_RETRY_INTERVAL 10
+#endif
+
+typedef struct split_sync_block_t {
+    void*   data;     // the shared state
+    void*   shadow;   // master: contents of data at the current version
+    uint8_t size;     // size of data and shadow
+    uint8_t version;  // master: current version, slave: last version received
+    uint8_t acked;    // master: last version the slave confirmed
+    uint8_t rejected; // master: last version the slave refused, not resent
+} split_sync_block_t;
+
+#define SPLIT_SYNC_BLOCK(data, shadow) \
+    { &(data), &(shadow), sizeof(data), 0, 0, 0 }
+
+void split_sync_init(int8_t transaction_id, split_sync_block_t* blocks, uint8_t count);
+void split_sync_task(void);
+
+// Called on the slave after a block has been updated
+void split_sync_received_kb(uint8_t block);
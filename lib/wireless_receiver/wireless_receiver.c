@@ -0,0 +1,119 @@
+/*
+Copyright 2012 Jun Wako
+Copyright 2014 Jack Humbert
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <string.h>
+#include "wireless_receiver.h"
+#include "timer.h"
+#include "uart.h"
+
+_Static_assert(WIRELESS_FRAME_END < WIRELESS_FRAME_SIZE, "WIRELESS_FRAME_END must be inside the frame");
+_Static_assert(MATRIX_ROWS * 2 <= WIRELESS_FRAME_SIZE, "the frame is too short for the matrix");
+
+static uint8_t  frame[WIRELESS_FRAME_SIZE];
+static uint8_t  frame_length;
+static uint16_t request_time;
+static uint16_t last_frame_time;
+
+static void request_frame(void) {
+    // anything still buffered belongs to an earlier request
+    while (uart_available()) {
+        uart_read();
+    }
+
+    frame_length = 0;
+    request_time = timer_read();
+
+    //the s character requests the RF slave to send the matrix
+    uart_write('s');
+}
+
+void wireless_receiver_init(uint32_t baud) {
+    uart_init(baud);
+    last_frame_time = timer_read();
+    request_frame();
+}
+
+__attribute__((weak)) bool wireless_receiver_decode(const uint8_t frame[], matrix_row_t rows[]) {
+    //check for the end packet, the key state bytes use the LSBs, so 0xE0
+    //will only show up here if the correct bytes were received
+    if (frame[WIRELESS_FRAME_END] != 0xE0) {
+        return false;
+    }
+
+    //shifting and transferring the keystates to the QMK matrix variable
+    for (uint8_t i = 0; i < MATRIX_ROWS; i++) {
+        rows[i] = (matrix_row_t)frame[i * 2] | (matrix_row_t)frame[i * 2 + 1] << WIRELESS_ROW_SHIFT;
+    }
+
+    return true;
+}
+
+static bool apply_frame(matrix_row_t current_matrix[]) {
+    matrix_row_t rows[MATRIX_ROWS] = {0};
+
+    if (!wireless_receiver_decode(frame, rows)) {
+        return false;
+    }
+
+    bool changed = memcmp(current_matrix, rows, sizeof(rows)) != 0;
+    memcpy(current_matrix, rows, sizeof(rows));
+    last_frame_time = timer_read();
+
+    return changed;
+}
+
+static bool release_all(matrix_row_t current_matrix[]) {
+    bool changed = false;
+
+    for (uint8_t i = 0; i < MATRIX_ROWS; i++) {
+        if (current_matrix[i]) {
+            changed = true;
+        }
+        current_matrix[i] = 0;
+    }
+
+    return changed;
+}
+
+bool wireless_receiver_scan(matrix_row_t current_matrix[]) {
+    bool changed = false;
+
+    // take whatever the receive interrupt has buffered so far
+    while (frame_length < WIRELESS_FRAME_SIZE && uart_available()) {
+        frame[frame_length++] = uart_read();
+    }
+
+    if (frame_length == WIRELESS_FRAME_SIZE || timer_elapsed(request_time) > WIRELESS_RESPONSE_TIMEOUT) {
+        // a short frame is padded, the decoder decides whether it is usable.
+        // No answer at all is left to the link timeout, an all zero frame
+        // passes some checksums.
+        if (frame_length > 0) {
+            memset(&frame[frame_length], 0, WIRELESS_FRAME_SIZE - frame_length);
+            changed = apply_frame(current_matrix);
+        }
+
+        request_frame();
+    }
+
+    // the bridge or its wire is gone, don't leave keys held down
+    if (timer_elapsed(last_frame_time) > WIRELESS_LINK_TIMEOUT) {
+        changed = release_all(current_matrix) || changed;
+    }
+
+    return changed;
+}
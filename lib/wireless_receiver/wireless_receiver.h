@@ -0,0 +1,68 @@
+/*
+Copyright 2012 Jun Wako
+Copyright 2014 Jack Humbert
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "matrix.h"
+
+/*
+ * Matrix from an nRF receiver bridge on the UART
+ *
+ * The matrix is requested with an 's' and the bridge answers with a frame of
+ * WIRELESS_FRAME_SIZE bytes. The frame is collected from the UART receive
+ * buffer across scans, so a scan never waits for it, and is then handed to
+ * wireless_receiver_decode(). Keys are released if no valid frame arrives for
+ * WIRELESS_LINK_TIMEOUT ms.
+ *
+ * The default decoder takes two bytes per row, the second shifted up by
+ * WIRELESS_ROW_SHIFT, and 0xE0 at WIRELESS_FRAME_END. Bridges with another
+ * format override wireless_receiver_decode().
+ */
+
+// bytes per frame
+#ifndef WIRELESS_FRAME_SIZE
+#    define WIRELESS_FRAME_SIZE 11
+#endif
+
+// position of the 0xE0 end byte
+#ifndef WIRELESS_FRAME_END
+#    define WIRELESS_FRAME_END (WIRELESS_FRAME_SIZE - 1)
+#endif
+
+// bit position of the second byte of each row
+#ifndef WIRELESS_ROW_SHIFT
+#    define WIRELESS_ROW_SHIFT 5
+#endif
+
+// ms to wait for a frame before taking what arrived and asking again
+#ifndef WIRELESS_RESPONSE_TIMEOUT
+#    define WIRELESS_RESPONSE_TIMEOUT 5
+#endif
+
+// ms without a valid frame before all keys are released
+#ifndef WIRELESS_LINK_TIMEOUT
+#    define WIRELESS_LINK_TIMEOUT 500
+#endif
+
+void wireless_receiver_init(uint32_t baud);
+// Unpack a frame into rows, false if it is not valid. Missing bytes of a
+// short frame are zeroed.
+bool wireless_receiver_decode(const uint8_t frame[], matrix_row_t rows[]);
+bool wireless_receiver_scan(matrix_row_t current_matrix[]);
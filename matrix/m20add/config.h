@@ -72,6 +72,9 @@
 
 #define DIODE_DIRECTION COL2ROW
 
+// rgb ring: one speed per custom effect
+#define EECONFIG_KB_DATA_SIZE 6
+
 // i2c setting
 #define I2C1_SCL_PIN B8
 #define I2C1_SDA_PIN B9
@@ -27,6 +27,13 @@ uint8_t read_pin(uint16_t pin)
     return (data & (1<<GET_PIN(pin))) ? 1 : 0;
 }
 
+void keyboard_post_init_kb(void) {
+#ifdef RGBLIGHT_ENABLE
+    rgb_ring_init();
+#endif
+    keyboard_post_init_user();
+}
+
 void housekeeping_task_kb(void) {
 #ifdef RGBLIGHT_ENABLE
     rgb_ring_task();
@@ -73,8 +73,14 @@ const is31fl3731_led_t PROGMEM g_is31fl3731_leds[IS31FL3731_LED_COUNT] = {
 #define RING_INNER_END      19
 #define RING_INNER_SIZE     (RING_INNER_END + 1 - RING_INNER_BEGIN)
 
+#define RING_LED_COUNT      (RING_INNER_END + 1)
+
 #define SPEED_MAX           100
 #define SPEED_STEP          10
+#define SPEED_DEFAULT       10
+
+// hue values in the effect tables are 8.8 fixed point
+#define HUE(h)              ((uint16_t)((h) * 256))
 
 typedef enum {
     RING_STATE_INIT,
@@ -92,43 +98,148 @@ typedef enum {
     RING_EFFECT_MAX
 } RING_EFFECT;
 
+_Static_assert(EECONFIG_KB_DATA_SIZE == RING_EFFECT_MAX, "EECONFIG_KB_DATA_SIZE must hold one speed per ring effect");
+
+typedef enum {
+    LAYER_KEEP,         // leave the leds as they are
+    LAYER_SOLID,        // every led at the frame hue
+    LAYER_GRADIENT,     // hue advances by spread from one led to the next
+    LAYER_MIRROR,       // two leds mirrored across the ring, moving by step every frame
+} RING_LAYER;
+
+typedef struct {
+    uint8_t     type;
+    uint8_t     origin;     // mirror: position at the first frame
+    uint8_t     step;       // mirror: positions moved per frame
+    bool        clear;      // mirror: turn the leds off instead
+    uint16_t    hue;        // added to the frame hue
+    uint16_t    spread;     // gradient: added per led
+} ring_layer_t;
+
 typedef struct {
-    uint8_t state;
-    uint8_t effect;
-    uint8_t speed;
-    uint8_t outer_index;
-    uint8_t inner_index;
-    uint8_t effect_count;
-    uint8_t led_begin;
-    uint8_t led_end;
-    bool    led_forward;
-    bool    led_clear;
+    uint8_t         frames;     // frames spent in this keyframe
+    ring_layer_t    outer;
+    ring_layer_t    inner;
+} ring_keyframe_t;
+
+typedef enum {
+    CLEAR_NONE,
+    CLEAR_START,        // all leds off when the effect starts
+    CLEAR_FRAME,        // all leds off before every frame
+} RING_CLEAR;
+
+typedef struct {
+    uint16_t                interval;   // frame time at speed 1, in ms
+    uint8_t                 count;      // frames before the next effect starts
+    uint8_t                 clear;
+    uint16_t                hue_step;   // frame hue change
+    uint8_t                 keyframe_count;
+    const ring_keyframe_t   *keyframes;
+} ring_effect_t;
+
+// outer ring in one color
+static const ring_keyframe_t effect_1_keyframes[] = {
+    {0, .outer = {LAYER_SOLID}},
+};
+
+// two leds running around the ring in opposite directions
+static const ring_keyframe_t effect_2_keyframes[] = {
+    {0, .outer = {LAYER_MIRROR, .origin = 0, .step = 1}},
+};
+
+// fill from both ends, empty from both ends, fill from the middle, empty from the middle
+static const ring_keyframe_t effect_3_keyframes[] = {
+    {RING_OUTER_SIZE/2, .outer = {LAYER_MIRROR, .origin = 0, .step = 1}},
+    {RING_OUTER_SIZE/2, .outer = {LAYER_MIRROR, .origin = 0, .step = 1, .clear = true}},
+    {RING_OUTER_SIZE/2, .outer = {LAYER_MIRROR, .origin = RING_OUTER_SIZE/2, .step = 1}},
+    {RING_OUTER_SIZE/2, .outer = {LAYER_MIRROR, .origin = RING_OUTER_SIZE/2, .step = 1, .clear = true}},
+};
+
+// as 2, skipping leds
+static const ring_keyframe_t effect_4_keyframes[] = {
+    {0, .outer = {LAYER_MIRROR, .origin = 0, .step = 3}},
+};
+
+// both rings in one color each
+static const ring_keyframe_t effect_5_keyframes[] = {
+    {0, .outer = {LAYER_SOLID, .hue = HUE(16)}, .inner = {LAYER_SOLID}},
+};
+
+// rainbow across both rings
+static const ring_keyframe_t effect_6_keyframes[] = {
+    {0, .outer = {LAYER_GRADIENT, .spread = HUE(10)}, .inner = {LAYER_GRADIENT, .hue = HUE(RING_INNER_BEGIN * 10), .spread = HUE(10)}},
+};
+
+static const ring_effect_t ring_effects[RING_EFFECT_MAX] = {
+    {1000, 64, CLEAR_NONE,  HUE(15), ARRAY_SIZE(effect_1_keyframes), effect_1_keyframes},
+    {1000, 64, CLEAR_FRAME, HUE(15), ARRAY_SIZE(effect_2_keyframes), effect_2_keyframes},
+    {1000, 64, CLEAR_START, HUE(15), ARRAY_SIZE(effect_3_keyframes), effect_3_keyframes},
+    {1000, 64, CLEAR_FRAME, HUE(15), ARRAY_SIZE(effect_4_keyframes), effect_4_keyframes},
+    {1000, 64, CLEAR_FRAME, HUE(16), ARRAY_SIZE(effect_5_keyframes), effect_5_keyframes},
+    {1000, 64, CLEAR_FRAME, HUE(10), ARRAY_SIZE(effect_6_keyframes), effect_6_keyframes},
+};
+
+typedef struct {
+    uint8_t     state;
+    uint8_t     effect;
+    uint8_t     speed[RING_EFFECT_MAX];
+    uint8_t     outer_index;
+    uint8_t     effect_count;
+    uint16_t    hue;
+    uint16_t    last_timer;
 } rgb_ring_t;
 
 static rgb_ring_t rgb_ring = {
     .state          = RING_STATE_INIT,
     .effect         = RING_EFFECT_1,
-    .speed          = 10,
     .outer_index    = 0,
-    .inner_index    = 0,
     .effect_count   = 0,
-    .led_begin      = RING_OUTER_BEGIN,
-    .led_end        = RING_OUTER_END,
-    .led_forward    = true,
-    .led_clear      = false,
 };
 
+// what the ring leds show, which of those are known and which the driver hasn't got yet
+static rgb_t    ring_leds[RING_LED_COUNT];
+static uint32_t ring_valid;
+static uint32_t ring_dirty;
+
+extern rgblight_config_t rgblight_config;
+
 static void rgb_ring_reset(void)
 {
     rgb_ring.effect_count   = 0;
-    rgb_ring.led_begin      = RING_OUTER_BEGIN;
-    rgb_ring.led_end        = RING_OUTER_END;
-    rgb_ring.led_forward    = true;
-    rgb_ring.led_clear      = false;
+    rgb_ring.hue            = rgblight_config.hue << 8;
+    // rgblight may have written the driver buffer since, so resend every led
+    ring_valid              = 0;
 }
 
-extern animation_status_t animation_status;
-extern rgblight_config_t rgblight_config;
+static void ring_set_color(uint8_t index, rgb_t c)
+{
+    if (!(ring_valid & (1UL << index)) || ring_leds[index].r != c.r || ring_leds[index].g != c.g || ring_leds[index].b != c.b) {
+        ring_leds[index] = c;
+        ring_valid |= 1UL << index;
+        ring_dirty |= 1UL << index;
+    }
+}
+
+static void ring_flush(void)
+{
+    if (!ring_dirty) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < RING_LED_COUNT; i++) {
+        if (ring_dirty & (1UL << i)) {
+            is31fl3731_set_color(i, ring_leds[i].r, ring_leds[i].g, ring_leds[i].b);
+        }
+    }
+    ring_dirty = 0;
+    is31fl3731_flush();
+}
+
+static rgb_t ring_hue_color(uint16_t hue)
+{
+    hsv_t h = {hue >> 8, rgblight_config.sat, rgblight_config.val};
+    return hsv_to_rgb(h);
+}
 
 #define EFFECT_TEST_INTERVAL    50
 #define EFFECT_TEST_COUNT       5
@@ -136,25 +247,25 @@ extern rgblight_config_t rgblight_config;
 #define EFFECT_TEST_VAL_STEP    17
 static void testing_mode(void)
 {
-    if (timer_elapsed(animation_status.last_timer) > EFFECT_TEST_INTERVAL) {
+    if (timer_elapsed(rgb_ring.last_timer) > EFFECT_TEST_INTERVAL) {
         hsv_t h = {rgblight_config.hue, rgblight_config.sat, rgblight_config.val};
         rgb_t c = hsv_to_rgb(h);
-        //is31fl3731_set_color_all(c.r, c.g, c.b);
-        is31fl3731_set_color_all(0, 0, 0);
-        is31fl3731_set_color(rgb_ring.outer_index+RING_OUTER_BEGIN, c.r, c.g, c.b);
+        for (uint8_t i = RING_OUTER_BEGIN; i <= RING_OUTER_END; i++) {
+            ring_set_color(i, i == rgb_ring.outer_index + RING_OUTER_BEGIN ? c : (rgb_t){0, 0, 0});
+        }
         h.v = EFFECT_TEST_VAL_STEP*rgb_ring.outer_index;
         c = hsv_to_rgb(h);
         for (uint8_t i = RING_INNER_BEGIN; i <= RING_INNER_END; i++) {
-            is31fl3731_set_color(i, c.r, c.g, c.b);
+            ring_set_color(i, c);
         }
+        ring_flush();
         rgb_ring.outer_index = (rgb_ring.outer_index + 1) % RING_OUTER_SIZE;
-        //rgb_ring.inner_index = (rgb_ring.inner_index + 1) % RING_INNER_SIZE;
 
         if (rgb_ring.outer_index == RING_OUTER_BEGIN) {
             rgblight_config.hue += EFFECT_TEST_HUE_STEP;
             rgb_ring.effect_count++;
         }
-        animation_status.last_timer = timer_read();
+        rgb_ring.last_timer = timer_read();
     }
     if (rgb_ring.effect_count > EFFECT_TEST_COUNT) {
         rgb_ring_reset();
@@ -163,202 +274,111 @@ static void testing_mode(void)
     }
 }
 
-static bool need_update(uint32_t max_interval)
+static uint32_t render_layer(const ring_layer_t *layer, uint8_t begin, uint8_t size, uint8_t frame, rgb_t *leds)
 {
-    uint32_t interval = timer_elapsed(animation_status.last_timer);
-    return (interval*rgb_ring.speed) > max_interval;
-}
-
-static void update_effect(uint32_t max_count)
-{
-    if (rgb_ring.effect_count > max_count) {
-        rgb_ring_reset();
-        rgb_ring.effect = (rgb_ring.effect + 1) % RING_EFFECT_MAX;
-    }
-}
-
-#define EFFECT_1_INTERVAL  1000
-#define EFFECT_1_COUNT     64
-#define EFFECT_1_HUE_STEP  15
+    uint16_t hue = rgb_ring.hue + layer->hue;
 
-static void ring_effect_no_1(void)
-{
-    if (need_update(EFFECT_1_INTERVAL)) {
-        hsv_t h = {rgblight_config.hue, rgblight_config.sat, rgblight_config.val};
-        for (uint8_t i = RING_OUTER_BEGIN; i <= RING_OUTER_END; i++) {
-            rgb_t c = hsv_to_rgb(h);
-            is31fl3731_set_color(i, c.r, c.g, c.b);
+    switch (layer->type) {
+        case LAYER_SOLID: {
+            rgb_t c = ring_hue_color(hue);
+            for (uint8_t i = 0; i < size; i++) {
+                leds[begin + i] = c;
+            }
+            return ((1UL << size) - 1) << begin;
         }
-        rgblight_config.hue += EFFECT_1_HUE_STEP;
-        rgb_ring.effect_count++;
-        animation_status.last_timer = timer_read();
+        case LAYER_GRADIENT:
+            for (uint8_t i = 0; i < size; i++) {
+                leds[begin + i] = ring_hue_color(hue + i * layer->spread);
+            }
+            return ((1UL << size) - 1) << begin;
+        case LAYER_MIRROR: {
+            rgb_t   c = layer->clear ? (rgb_t){0, 0, 0} : ring_hue_color(hue);
+            uint8_t pos = (layer->origin + frame * layer->step) % size;
+            leds[begin + pos] = c;
+            leds[begin + size - 1 - pos] = c;
+            return (1UL << (begin + pos)) | (1UL << (begin + size - 1 - pos));
+        }
+        default:
+            return 0;
     }
-
-    update_effect(EFFECT_1_COUNT);
 }
 
-#define EFFECT_2_INTERVAL  1000
-#define EFFECT_2_COUNT     64
-#define EFFECT_2_HUE_STEP  15
-
-static void ring_effect_no_2(void)
+static void render_frame(const ring_effect_t *effect, uint8_t frame)
 {
-    if (need_update(EFFECT_2_INTERVAL)) {
-        is31fl3731_set_color_all(0, 0, 0);
-        hsv_t h = {rgblight_config.hue, rgblight_config.sat, rgblight_config.val};
-        rgb_t c = hsv_to_rgb(h);
-
-        is31fl3731_set_color(rgb_ring.led_begin, c.r, c.g, c.b);
-        is31fl3731_set_color(rgb_ring.led_end, c.r, c.g, c.b);
+    rgb_t    leds[RING_LED_COUNT] = {0};
+    uint32_t touched = 0;
 
-        rgb_ring.led_begin = (rgb_ring.led_begin + 1) % RING_OUTER_SIZE;
-        rgb_ring.led_end = (rgb_ring.led_end + RING_OUTER_SIZE - 1) % RING_OUTER_SIZE;
-
-        rgblight_config.hue += EFFECT_2_HUE_STEP;
-        rgb_ring.effect_count++;
-        animation_status.last_timer = timer_read();
+    if (effect->clear == CLEAR_FRAME || (effect->clear == CLEAR_START && frame == 0)) {
+        touched = (1UL << RING_LED_COUNT) - 1;
     }
 
-    update_effect(EFFECT_2_COUNT);
-}
-
-#define EFFECT_3_INTERVAL  1000
-#define EFFECT_3_COUNT     64
-#define EFFECT_3_HUE_STEP  15
-
-static void ring_effect_no_3(void)
-{
-    if (rgb_ring.effect_count == 0) {
-        is31fl3731_set_color_all(0, 0, 0);
+    // find the keyframe and the frame within it, a keyframe of length 0 runs to the end
+    const ring_keyframe_t *keyframe = effect->keyframes;
+    uint16_t length = 0;
+    for (uint8_t i = 0; i < effect->keyframe_count; i++) {
+        length += effect->keyframes[i].frames;
     }
-
-    if (need_update(EFFECT_3_INTERVAL)) {
-        hsv_t h = {rgblight_config.hue, rgblight_config.sat, rgblight_config.val};
-
-        if (rgb_ring.led_clear) {
-            is31fl3731_set_color(rgb_ring.led_begin, 0, 0, 0);
-            is31fl3731_set_color(rgb_ring.led_end, 0, 0, 0);
-        } else {
-            rgb_t c = hsv_to_rgb(h);
-            is31fl3731_set_color(rgb_ring.led_begin, c.r, c.g, c.b);
-            is31fl3731_set_color(rgb_ring.led_end, c.r, c.g, c.b);
+    if (length) {
+        frame %= length;
+        while (frame >= keyframe->frames) {
+            frame -= keyframe->frames;
+            keyframe++;
         }
+    }
 
-        rgb_ring.led_begin = (rgb_ring.led_begin + 1) % RING_OUTER_SIZE;
-        if (rgb_ring.led_begin == rgb_ring.led_end) {
-            if (rgb_ring.led_forward) {
-                rgb_ring.led_begin = RING_OUTER_BEGIN;
-                rgb_ring.led_end = RING_OUTER_END+1;
-            } else {
-                rgb_ring.led_begin = RING_OUTER_BEGIN + RING_OUTER_SIZE/2;
-                rgb_ring.led_end = RING_OUTER_END+1 - RING_OUTER_SIZE/2;
-            }
-
-            if (!rgb_ring.led_clear) {
-                rgb_ring.led_forward = !rgb_ring.led_forward;
-            }
+    touched |= render_layer(&keyframe->outer, RING_OUTER_BEGIN, RING_OUTER_SIZE, frame, leds);
+    touched |= render_layer(&keyframe->inner, RING_INNER_BEGIN, RING_INNER_SIZE, frame, leds);
 
-            rgb_ring.led_clear = !rgb_ring.led_clear;
+    // leds no layer touched keep what they show
+    for (uint8_t i = 0; i < RING_LED_COUNT; i++) {
+        if (touched & (1UL << i)) {
+            ring_set_color(i, leds[i]);
         }
-
-        rgb_ring.led_end = (rgb_ring.led_end + RING_OUTER_SIZE - 1) % RING_OUTER_SIZE;
-
-        rgblight_config.hue += EFFECT_3_HUE_STEP;
-        rgb_ring.effect_count++;
-        animation_status.last_timer = timer_read();
     }
-
-    update_effect(EFFECT_3_COUNT);
 }
 
-#define EFFECT_4_INTERVAL  1000
-#define EFFECT_4_COUNT     64
-#define EFFECT_4_STEP      3
-static void ring_effect_no_4(void)
+static void custom_effects(void)
 {
-    if (need_update(EFFECT_4_INTERVAL)) {
-        is31fl3731_set_color_all(0, 0, 0);
-        hsv_t h = {rgblight_config.hue, rgblight_config.sat, rgblight_config.val};
-        rgb_t c = hsv_to_rgb(h);
-
-        is31fl3731_set_color(rgb_ring.led_begin, c.r, c.g, c.b);
-        is31fl3731_set_color(rgb_ring.led_end, c.r, c.g, c.b);
+    const ring_effect_t *effect = &ring_effects[rgb_ring.effect];
 
-        rgb_ring.led_begin = (rgb_ring.led_begin + EFFECT_4_STEP) % RING_OUTER_SIZE;
-        rgb_ring.led_end = (rgb_ring.led_end + RING_OUTER_SIZE - EFFECT_4_STEP) % RING_OUTER_SIZE;
+    // keep a hue the user set since the last frame
+    if (rgblight_config.hue != (rgb_ring.hue >> 8)) {
+        rgb_ring.hue = rgblight_config.hue << 8;
+    }
 
-        rgblight_config.hue += EFFECT_1_HUE_STEP;
+    if ((uint32_t)timer_elapsed(rgb_ring.last_timer) * rgb_ring.speed[rgb_ring.effect] > effect->interval) {
+        render_frame(effect, rgb_ring.effect_count);
+        rgb_ring.hue += effect->hue_step;
+        rgblight_config.hue = rgb_ring.hue >> 8;
         rgb_ring.effect_count++;
-        animation_status.last_timer = timer_read();
+        rgb_ring.last_timer = timer_read();
     }
 
-    update_effect(EFFECT_4_COUNT);
-}
+    ring_flush();
 
-#define EFFECT_5_INTERVAL  1000
-#define EFFECT_5_COUNT     64
-#define EFFECT_5_HUE_STEP  16
-static void ring_effect_no_5(void)
-{
-    if (need_update(EFFECT_5_INTERVAL)) {
-        is31fl3731_set_color_all(0, 0, 0);
-        for (uint8_t i = RING_INNER_BEGIN; i <= RING_INNER_END; i++) {
-            hsv_t h = {rgblight_config.hue, rgblight_config.sat, rgblight_config.val};
-            rgb_t c = hsv_to_rgb(h);
-            is31fl3731_set_color(i, c.r, c.g, c.b);
-        }
-        for (uint8_t i = RING_OUTER_BEGIN; i <= RING_OUTER_END; i++) {
-            hsv_t h = {rgblight_config.hue+EFFECT_5_HUE_STEP, rgblight_config.sat, rgblight_config.val};
-            rgb_t c = hsv_to_rgb(h);
-            is31fl3731_set_color(i, c.r, c.g, c.b);
-        }
-        rgblight_config.hue += EFFECT_5_HUE_STEP;
-        rgb_ring.effect_count++;
-        animation_status.last_timer = timer_read();
+    if (rgb_ring.effect_count > effect->count) {
+        rgb_ring_reset();
+        rgb_ring.effect = (rgb_ring.effect + 1) % RING_EFFECT_MAX;
     }
-
-    update_effect(EFFECT_5_COUNT);
 }
 
-#define EFFECT_6_INTERVAL  1000
-#define EFFECT_6_COUNT     64
-#define EFFECT_I_HUE_STEP  10
-#define EFFECT_O_HUE_STEP  10
-static void ring_effect_no_6(void)
+static void ring_change_speed(int8_t step)
 {
-    if (need_update(EFFECT_6_INTERVAL)) {
-        is31fl3731_set_color_all(0, 0, 0);
-        for (uint8_t i = RING_INNER_BEGIN; i <= RING_INNER_END; i++) {
-            hsv_t h = {rgblight_config.hue+i*EFFECT_I_HUE_STEP, rgblight_config.sat, rgblight_config.val};
-            rgb_t c = hsv_to_rgb(h);
-            is31fl3731_set_color(i, c.r, c.g, c.b);
-        }
-        for (uint8_t i = RING_OUTER_BEGIN; i <= RING_OUTER_END; i++) {
-            hsv_t h = {rgblight_config.hue+i*EFFECT_O_HUE_STEP, rgblight_config.sat, rgblight_config.val};
-            rgb_t c = hsv_to_rgb(h);
-            is31fl3731_set_color(i, c.r, c.g, c.b);
-        }
-        rgblight_config.hue += EFFECT_I_HUE_STEP;
-        rgb_ring.effect_count++;
-        animation_status.last_timer = timer_read();
-    }
-
-    update_effect(EFFECT_6_COUNT);
+    int16_t speed = rgb_ring.speed[rgb_ring.effect] + step;
+    rgb_ring.speed[rgb_ring.effect] = speed < 1 ? 1 : speed > SPEED_MAX ? SPEED_MAX : speed;
+    eeconfig_update_kb_datablock(rgb_ring.speed);
 }
 
-typedef void(*effect_fun)(void);
-static effect_fun effect_funcs[RING_EFFECT_MAX] = {
-    ring_effect_no_1,
-    ring_effect_no_2,
-    ring_effect_no_3,
-    ring_effect_no_4,
-    ring_effect_no_5,
-    ring_effect_no_6,
-};
-
-static void custom_effects(void)
+void rgb_ring_init(void)
 {
-    effect_funcs[rgb_ring.effect]();
+    eeconfig_read_kb_datablock(rgb_ring.speed);
+    for (uint8_t i = 0; i < RING_EFFECT_MAX; i++) {
+        // cleared or out of range after an eeprom reset
+        if (rgb_ring.speed[i] == 0 || rgb_ring.speed[i] > SPEED_MAX) {
+            rgb_ring.speed[i] = SPEED_DEFAULT;
+        }
+    }
+    rgb_ring_reset();
 }
 
 void flush_custom(void) {
@@ -412,6 +432,7 @@ bool process_record_kb(uint16_t keycode, keyrecord_t *record)
                     // in qmk mode, switch to custom mode?
                     if (rgblight_config.mode >= RGBLIGHT_MODES) {
                         rgb_ring.state = RING_STATE_CUSTOM;
+                        rgb_ring_reset();
                         return false;
                     }
                 }
@@ -430,10 +451,18 @@ bool process_record_kb(uint16_t keycode, keyrecord_t *record)
                     // in qmk mode, switch to custom mode?
                     if (rgblight_config.mode <= 1) {
                         rgb_ring.state = RING_STATE_CUSTOM;
+                        rgb_ring_reset();
                         return false;
                     }
                 }
                 break;
+            case QK_UNDERGLOW_SPEED_UP:
+            case QK_UNDERGLOW_SPEED_DOWN:
+                if (rgb_ring.state == RING_STATE_CUSTOM) {
+                    ring_change_speed(keycode == QK_UNDERGLOW_SPEED_UP ? SPEED_STEP : -SPEED_STEP);
+                    return false;
+                }
+                break;
             case KC_F24:
                 if (rgb_ring.state == RING_STATE_QMK) {
                     rgb_ring.state = RING_STATE_CUSTOM;
@@ -19,4 +19,5 @@
 
 #pragma once
 
+void rgb_ring_init(void);
 void rgb_ring_task(void);
@@ -23,7 +23,12 @@ which is connected to the USB port.
 
 Possible functionality includes the ability to send data from the host to the remote using
 a reverse link, allowing for LED sync, configuration, and more data sharing between devices.
-This will require a new communication protocol, as the current one is limited.
+
+Key events are batched into one frame per scan. Frames are COBS encoded with a
+CRC-8 and a sequence number, so the host can tell when frames were lost and ask
+the remote for its held keys over the reverse link. When idle, the remote sends
+its held keys as a heartbeat, so a lost final release is corrected even without
+a reverse link.
 */
 
 #include "remote_kb.h"
@@ -31,14 +36,35 @@ This will require a new communication protocol, as the current one is limited.
 #include "uart.h"
 #include "wait.h"
 #include "debug.h"
-
-uint8_t
- msg[UART_MSG_LEN],
- msg_idx = 0;
+#include <string.h>
 
 bool
  is_host = true;
 
+// Link state
+static uint8_t
+ rx_buf[RK_ENCODED_LEN],
+ rx_len = 0,
+ tx_events[RK_MAX_EVENTS * RK_EVENT_LEN],
+ tx_count = 0,
+ tx_seq = 0,
+ rx_seq = 0;
+
+static bool
+ rx_overflow = false,
+ rx_synced = false;
+
+// Last frame sent by the remote, or received by the host
+static uint16_t
+ link_timer = 0;
+
+// Keys held by the remote, tracked on both ends
+static uint16_t
+ held[RK_MAX_HELD];
+
+static uint8_t
+ held_count = 0;
+
 // Private functions
 
 static bool vbus_detect(void) {
@@ -52,88 +78,246 @@ static bool vbus_detect(void) {
   #endif
 }
 
-static uint8_t chksum8(const unsigned char *buf, size_t len) {
-  unsigned int sum;
-  for (sum = 0 ; len != 0 ; len--)
-    sum += *(buf++);
-  return (uint8_t)sum;
+// CRC-8, polynomial 0x07
+static uint8_t crc8(const uint8_t *buf, uint8_t len) {
+  uint8_t crc = 0;
+  while (len--) {
+    crc ^= *(buf++);
+    for (uint8_t i = 0; i < 8; i++)
+      crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : (crc << 1);
+  }
+  return crc;
 }
 
-static void send_msg(uint16_t keycode, bool pressed) {
-  msg[IDX_PREAMBLE] = UART_PREAMBLE;
-  msg[IDX_KCLSB] = (keycode & 0xFF);
-  msg[IDX_KCMSB] = (keycode >> 8) & 0xFF;
-  msg[IDX_PRESSED] = pressed;
-  msg[IDX_CHECKSUM] = chksum8(msg, UART_MSG_LEN-1);
-  uart_transmit(msg, UART_MSG_LEN);
+// COBS removes every 0x00 from the frame so 0x00 can mark its end
+static uint8_t cobs_encode(const uint8_t *in, uint8_t len, uint8_t *out) {
+  uint8_t code_idx = 0, code = 1, o = 1;
+  for (uint8_t i = 0; i < len; i++) {
+    if (in[i] == 0) {
+      out[code_idx] = code;
+      code_idx = o++;
+      code = 1;
+    } else {
+      out[o++] = in[i];
+      if (++code == 0xFF) {
+        out[code_idx] = code;
+        code_idx = o++;
+        code = 1;
+      }
+    }
+  }
+  out[code_idx] = code;
+  return o;
 }
 
-static inline void print_message_buffer(void) {
-  for (int i=0; i<UART_MSG_LEN; i++) {
-    dprintf("msg[%u]: 0x%02X\n", i, msg[i]);
+// Returns the decoded length, 0 if the input is malformed
+static uint8_t cobs_decode(const uint8_t *in, uint8_t len, uint8_t *out) {
+  uint8_t i = 0, o = 0;
+  while (i < len) {
+    uint8_t code = in[i++];
+    if (code == 0 || i + code - 1 > len) return 0;
+    for (uint8_t j = 1; j < code; j++) out[o++] = in[i++];
+    if (code < 0xFF && i < len) out[o++] = 0;
   }
+  return o;
 }
 
-static void process_uart(void) {
-  uint8_t chksum = chksum8(msg, UART_MSG_LEN-1);
-  if (msg[IDX_PREAMBLE] != UART_PREAMBLE || msg[IDX_CHECKSUM] != chksum) {
-     dprintf("UART checksum mismatch!\n");
-     print_message_buffer();
-     dprintf("calc checksum: 0x%02X\n", chksum);
+static void send_frame(uint8_t type, uint8_t seq, const uint8_t *payload, uint8_t len) {
+  uint8_t frame[RK_FRAME_LEN], encoded[RK_ENCODED_LEN];
+  frame[0] = type;
+  frame[1] = seq;
+  memcpy(&frame[RK_HEADER_LEN], payload, len);
+  len += RK_HEADER_LEN;
+  frame[len] = crc8(frame, len);
+  len = cobs_encode(frame, len + 1, encoded);
+  uart_transmit(encoded, len);
+  uart_write(0);
+}
+
+static void held_add(uint16_t keycode) {
+  for (uint8_t i = 0; i < held_count; i++) {
+    if (held[i] == keycode) return;
+  }
+  if (held_count < RK_MAX_HELD) held[held_count++] = keycode;
+}
+
+static void held_remove(uint16_t keycode) {
+  for (uint8_t i = 0; i < held_count; i++) {
+    if (held[i] == keycode) {
+      held[i] = held[--held_count];
+      return;
+    }
+  }
+}
+
+static void release_all(void) {
+  while (held_count) {
+    unregister_code(held[--held_count]);
+  }
+}
+
+static uint16_t event_keycode(const uint8_t *event) {
+  return (uint16_t)event[0] | ((uint16_t)event[1] << 8);
+}
+
+static void process_event(const uint8_t *event) {
+  uint16_t keycode = event_keycode(event);
+  bool pressed = (bool)event[2];
+  if (IS_RM_KC(keycode)) {
+    keyrecord_t record;
+    record.event.pressed = pressed;
+    if (pressed) dprintf("Remote macro: press [%u]\n", keycode);
+    else dprintf("Remote macro: release [%u]\n", keycode);
+    process_record_user(keycode, &record);
   } else {
-    uint16_t keycode = (uint16_t)msg[IDX_KCLSB] | ((uint16_t)msg[IDX_KCMSB] << 8);
-    bool pressed = (bool)msg[IDX_PRESSED];
-    if (IS_RM_KC(keycode)) {
-      keyrecord_t record;
-      record.event.pressed = pressed;
-      if (pressed) dprintf("Remote macro: press [%u]\n", keycode);
-      else dprintf("Remote macro: release [%u]\n", keycode);
-      process_record_user(keycode, &record);
+    if (pressed) {
+      dprintf("Remote: press [%u]\n", keycode);
+      register_code(keycode);
+      held_add(keycode);
     } else {
-      if (pressed) {
-        dprintf("Remote: press [%u]\n", keycode);
-        register_code(keycode);
-    } else {
-        dprintf("Remote: release [%u]\n", keycode);
-        unregister_code(keycode);
-      }
+      dprintf("Remote: release [%u]\n", keycode);
+      unregister_code(keycode);
+      held_remove(keycode);
+    }
+  }
+}
+
+// Bring the keys the host holds in line with the remote's, touching only
+// the keys that differ
+static void apply_state(const uint8_t *events, uint8_t count) {
+  for (uint8_t i = held_count; i-- > 0;) {
+    bool still_held = false;
+    for (uint8_t j = 0; j < count; j++) {
+      if (event_keycode(&events[j * RK_EVENT_LEN]) == held[i]) still_held = true;
+    }
+    if (!still_held) {
+      dprintf("Remote: resync release [%u]\n", held[i]);
+      unregister_code(held[i]);
+      held[i] = held[--held_count];
+    }
+  }
+
+  for (uint8_t j = 0; j < count; j++) {
+    uint16_t keycode = event_keycode(&events[j * RK_EVENT_LEN]);
+    bool already_held = false;
+    for (uint8_t i = 0; i < held_count; i++) {
+      if (held[i] == keycode) already_held = true;
     }
+    if (!already_held) process_event(&events[j * RK_EVENT_LEN]);
+  }
+}
+
+static void send_events(void) {
+  if (tx_count == 0) return;
+  send_frame(RK_FRAME_EVENTS, tx_seq++, tx_events, tx_count * RK_EVENT_LEN);
+  tx_count = 0;
+  link_timer = timer_read();
+}
+
+static void send_state(void) {
+  uint8_t payload[RK_PAYLOAD_LEN];
+  for (uint8_t i = 0; i < held_count; i++) {
+    payload[i * RK_EVENT_LEN] = held[i] & 0xFF;
+    payload[i * RK_EVENT_LEN + 1] = (held[i] >> 8) & 0xFF;
+    payload[i * RK_EVENT_LEN + 2] = true;
   }
+  // Carries the sequence number of the next EVENTS frame
+  send_frame(RK_FRAME_STATE, tx_seq, payload, held_count * RK_EVENT_LEN);
+  link_timer = timer_read();
 }
 
+static void process_frame(const uint8_t *frame, uint8_t len) {
+  if (len < RK_HEADER_LEN + 1 || frame[len-1] != crc8(frame, len-1)) {
+    dprintf("Remote: bad frame\n");
+    return;
+  }
+
+  const uint8_t *events = &frame[RK_HEADER_LEN];
+  uint8_t count = (len - RK_HEADER_LEN - 1) / RK_EVENT_LEN;
+  link_timer = timer_read();
+
+  switch (frame[0]) {
+    case RK_FRAME_EVENTS:
+      if (rx_synced && frame[1] != rx_seq) {
+        // Events went missing, ask for the remote's keys rather than wait
+        // for the next heartbeat
+        dprintf("Remote: lost %u frames, resync\n", (uint8_t)(frame[1] - rx_seq));
+        send_frame(RK_FRAME_RESYNC, 0, NULL, 0);
+      }
+      for (uint8_t i = 0; i < count; i++) {
+        process_event(&events[i * RK_EVENT_LEN]);
+      }
+      rx_seq = frame[1] + 1;
+      rx_synced = true;
+      break;
+
+    case RK_FRAME_STATE:
+      apply_state(events, count);
+      rx_seq = frame[1];
+      rx_synced = true;
+      break;
+
+    case RK_FRAME_RESYNC:
+      send_events();
+      send_state();
+      break;
+  }
+}
+
+// Handle every complete frame waiting in the UART buffer
 static void get_msg(void) {
   while (uart_available()) {
-    msg[msg_idx] = uart_read();
-    dprintf("idx: %u, recv: 0x%002X\n", msg_idx, msg[msg_idx]);
-    if (msg_idx == 0 && (msg[msg_idx] != UART_PREAMBLE)) {
-      dprintf("Byte sync error!\n");
-      msg_idx = 0;
-    } else if (msg_idx == (UART_MSG_LEN-1)) {
-      process_uart();
-      msg_idx = 0;
-      break;
+    uint8_t data = uart_read();
+    if (data == 0) {
+      uint8_t frame[RK_FRAME_LEN];
+      uint8_t len = rx_overflow ? 0 : cobs_decode(rx_buf, rx_len, frame);
+      if (len) process_frame(frame, len);
+      rx_len = 0;
+      rx_overflow = false;
+    } else if (rx_len < sizeof(rx_buf)) {
+      rx_buf[rx_len++] = data;
     } else {
-      msg_idx++;
+      rx_overflow = true;
     }
   }
 }
 
 static void handle_host_incoming(void) {
   get_msg();
+
+  // No heartbeat either, the remote is gone
+  if (held_count && timer_elapsed(link_timer) > RK_LINK_TIMEOUT) {
+    dprintf("Remote: link lost\n");
+    release_all();
+  }
 }
 
 static void handle_host_outgoing(void) {
-  // for future reverse link use
+  // resync requests are sent as soon as a gap is seen
 }
 
 static void handle_remote_incoming(void) {
-  // for future reverse link use
+  get_msg();
+}
+
+static void send_remote_frames(void) {
+  send_events();
+  if (timer_elapsed(link_timer) > RK_HEARTBEAT_INTERVAL) send_state();
 }
 
 static void handle_remote_outgoing(uint16_t keycode, keyrecord_t *record) {
   if (IS_HID_KC(keycode) || IS_RM_KC(keycode)) {
     dprintf("Remote: send [%u]\n", keycode);
-    send_msg(keycode, record->event.pressed);
+    if (tx_count == RK_MAX_EVENTS) send_events();
+    uint8_t *event = &tx_events[tx_count++ * RK_EVENT_LEN];
+    event[0] = keycode & 0xFF;
+    event[1] = (keycode >> 8) & 0xFF;
+    event[2] = record->event.pressed;
+
+    if (IS_HID_KC(keycode)) {
+      if (record->event.pressed) held_add(keycode);
+      else held_remove(keycode);
+    }
   }
 }
 
@@ -167,6 +351,7 @@ void matrix_scan_remote_kb(void) {
 
   #elif defined (KEYBOARD_REMOTE)
   handle_remote_incoming();
+  send_remote_frames();
 
   #else //auto check with VBUS
   if (is_host) {
@@ -174,6 +359,7 @@ void matrix_scan_remote_kb(void) {
   }
   else {
     handle_remote_incoming();
+    send_remote_frames();
   }
   #endif
 }
@@ -20,15 +20,35 @@
 
 #define SERIAL_UART_BAUD 76800 //low error rate for 32u4 @ 16MHz
 
-#define UART_PREAMBLE 0x69
-#define UART_MSG_LEN  5
-#define UART_NULL     0
-
-#define IDX_PREAMBLE  0
-#define IDX_KCLSB     1
-#define IDX_KCMSB     2
-#define IDX_PRESSED   3
-#define IDX_CHECKSUM  4
+/* Link framing: every frame is COBS encoded and ends in a 0x00 delimiter.
+ * Decoded, a frame is [type][seq][payload...][crc8]. EVENTS and STATE frames
+ * carry events of [kc lsb][kc msb][pressed], up to RK_MAX_EVENTS per EVENTS
+ * frame and RK_MAX_HELD per STATE frame. */
+#define RK_FRAME_EVENTS  1 // remote -> host: key events since the last frame
+#define RK_FRAME_STATE   2 // remote -> host: every key the remote holds, also the idle heartbeat
+#define RK_FRAME_RESYNC  3 // host -> remote: please send STATE
+
+#define RK_EVENT_LEN     3
+#define RK_HEADER_LEN    2
+#ifndef RK_MAX_EVENTS
+#define RK_MAX_EVENTS    8
+#endif
+#ifndef RK_MAX_HELD
+#define RK_MAX_HELD      16
+#endif
+
+// The remote sends STATE after this many ms without a frame, and the host
+// releases the remote's keys after RK_LINK_TIMEOUT ms without one
+#ifndef RK_HEARTBEAT_INTERVAL
+#define RK_HEARTBEAT_INTERVAL 100
+#endif
+#ifndef RK_LINK_TIMEOUT
+#define RK_LINK_TIMEOUT  (RK_HEARTBEAT_INTERVAL * 5)
+#endif
+
+#define RK_PAYLOAD_LEN   ((RK_MAX_HELD > RK_MAX_EVENTS ? RK_MAX_HELD : RK_MAX_EVENTS) * RK_EVENT_LEN)
+#define RK_FRAME_LEN     (RK_HEADER_LEN + RK_PAYLOAD_LEN + 1)
+#define RK_ENCODED_LEN   (RK_FRAME_LEN + 1) // COBS overhead, not counting the delimiter
 
 #define IS_HID_KC(x) ((x > 0) && (x < 0xFF))
 #define IS_RM_KC(x) ((x >= RM_BASE) && (x <= 0xFFFF))
@@ -1,5 +1,7 @@
+#include <string.h>
 #include "ws2812.h"
 #include "i2c_master.h"
+#include "timer.h"
 
 #ifdef WS2812_RGBW
 #    error "RGBW not supported"
@@ -17,8 +19,22 @@
 #    define WS2812_I2C_TIMEOUT 100
 #endif
 
+// A half that was reset or replugged keeps acknowledging nothing, so both
+// halves are sent again this often even if unchanged
+#ifndef WS2812_RESEND_INTERVAL
+#    define WS2812_RESEND_INTERVAL 1000
+#endif
+
+#define WS2812_LEFT_COUNT (WS2812_LED_COUNT >> 1)
+#define WS2812_RIGHT_COUNT (WS2812_LED_COUNT - WS2812_LEFT_COUNT)
+
 ws2812_led_t ws2812_leds[WS2812_LED_COUNT];
 
+// Last buffer each half acknowledged, so unchanged halves are not resent
+static ws2812_led_t ws2812_sent[WS2812_LED_COUNT];
+static bool         ws2812_sent_valid[2];
+static uint16_t     ws2812_resend_timer;
+
 void ws2812_init(void) {
     i2c_init();
 }
@@ -35,7 +51,30 @@ void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
     }
 }
 
+static void ws2812_flush_half(uint8_t half, uint8_t address, uint8_t first, uint8_t count) {
+    uint16_t size = sizeof(ws2812_led_t) * count;
+
+    if (ws2812_sent_valid[half] && memcmp(&ws2812_leds[first], &ws2812_sent[first], size) == 0) {
+        return;
+    }
+
+    // The receiver always loads from its first LED, so a half goes out whole
+    if (i2c_transmit(address, (uint8_t *)&ws2812_leds[first], size, WS2812_I2C_TIMEOUT) == I2C_STATUS_SUCCESS) {
+        memcpy(&ws2812_sent[first], &ws2812_leds[first], size);
+        ws2812_sent_valid[half] = true;
+    } else {
+        // Try again on the next flush
+        ws2812_sent_valid[half] = false;
+    }
+}
+
 void ws2812_flush(void) {
-    i2c_transmit(WS2812_I2C_ADDRESS, (uint8_t *)ws2812_leds, sizeof(ws2812_led_t) * (WS2812_LED_COUNT >> 1), WS2812_I2C_TIMEOUT);
-    i2c_transmit(WS2812_I2C_ADDRESS_RIGHT, (uint8_t *)ws2812_leds + (sizeof(ws2812_led_t) * (WS2812_LED_COUNT >> 1)), sizeof(ws2812_led_t) * (WS2812_LED_COUNT - (WS2812_LED_COUNT >> 1)), WS2812_I2C_TIMEOUT);
+    if (timer_elapsed(ws2812_resend_timer) > WS2812_RESEND_INTERVAL) {
+        ws2812_resend_timer  = timer_read();
+        ws2812_sent_valid[0] = false;
+        ws2812_sent_valid[1] = false;
+    }
+
+    ws2812_flush_half(0, WS2812_I2C_ADDRESS, 0, WS2812_LEFT_COUNT);
+    ws2812_flush_half(1, WS2812_I2C_ADDRESS_RIGHT, WS2812_LEFT_COUNT, WS2812_RIGHT_COUNT);
 }
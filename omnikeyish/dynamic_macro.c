@@ -3,22 +3,114 @@
 
 dynamic_macro_t dynamic_macros[DYNAMIC_MACRO_COUNT];
 
+_Static_assert(MATRIX_ROWS <= 8 && MATRIX_COLS <= 32, "dynamic macro event encoding needs row < 8 and col < 32");
+
+/* Recording state */
+static uint32_t last_event_time;
+
+/* Playback state */
+static uint8_t  playing_id = 255;
+static uint16_t playing_pos;
+static uint32_t playing_next;
+static uint32_t playing_saved_layer_state;
+
+/* LED blink state */
+static bool     blink_active = false;
+static uint16_t blink_timer;
+
 void dynamic_macro_init(void) {
   /* zero out macro blocks  */
   memset(&dynamic_macros, 0, DYNAMIC_MACRO_COUNT * sizeof(dynamic_macro_t));
 }
 
-/* Blink the LEDs to notify the user about some event. */
+/* Blink the LEDs to notify the user about some event. The LEDs are
+ * restored by dynamic_macro_task() so the keyboard isn't blocked. */
 void dynamic_macro_led_blink(void) {
+  if (blink_active) {
+    return;
+  }
 #ifdef BACKLIGHT_ENABLE
   backlight_toggle();
-  wait_ms(100);
-  backlight_toggle();
 #else
   led_set(host_keyboard_leds() ^ 0xFF);
-  wait_ms(100);
+#endif
+  blink_active = true;
+  blink_timer  = timer_read();
+}
+
+static void dynamic_macro_led_blink_task(void) {
+  if (!blink_active || timer_elapsed(blink_timer) < DYNAMIC_MACRO_BLINK_DURATION) {
+    return;
+  }
+#ifdef BACKLIGHT_ENABLE
+  backlight_toggle();
+#else
   led_set(host_keyboard_leds());
 #endif
+  blink_active = false;
+}
+
+/**
+ * Encode a single event.
+ *
+ * @param buf[out]      At least DYNAMIC_MACRO_EVENT_MAX_SIZE bytes
+ * @param event[in]     The key event
+ * @param delay[in]     Milliseconds since the previous event
+ * @return              Number of bytes written
+ */
+static uint8_t dynamic_macro_encode_event(uint8_t* buf, keyevent_t* event, uint32_t delay) {
+  uint8_t size = 0;
+
+  if (delay > DYNAMIC_MACRO_MAX_DELAY) {
+    delay = DYNAMIC_MACRO_MAX_DELAY;
+  }
+
+  buf[size++] = event->key.row << 5 | event->key.col;
+
+  uint32_t value = delay << 1 | (event->pressed ? 1 : 0);
+  while (value >= 0x80) {
+    buf[size++] = (value & 0x7F) | 0x80;
+    value >>= 7;
+  }
+  buf[size++] = value;
+
+  return size;
+}
+
+/**
+ * Decode a single event.
+ *
+ * @param macro[in]     The macro to read from
+ * @param pos[in,out]   Offset of the event, advanced past it
+ * @param event[out]    The key event
+ * @param delay[out]    Milliseconds since the previous event
+ * @return              false if the event is truncated
+ */
+static bool dynamic_macro_decode_event(dynamic_macro_t* macro, uint16_t* pos, keyevent_t* event, uint32_t* delay) {
+  uint16_t p = *pos;
+
+  if (p >= macro->length) {
+    return false;
+  }
+  uint8_t key = macro->data[p++];
+
+  uint32_t value = 0;
+  uint8_t  shift = 0;
+  uint8_t  byte;
+  do {
+    if (p >= macro->length || shift > 14) {
+      return false;
+    }
+    byte = macro->data[p++];
+    value |= (uint32_t)(byte & 0x7F) << shift;
+    shift += 7;
+  } while (byte & 0x80);
+
+  *event = MAKE_KEYEVENT(key >> 5, key & 0x1F, value & 1);
+  *delay = value >> 1;
+  *pos   = p;
+
+  return true;
 }
 
 /**
@@ -29,6 +121,7 @@ void dynamic_macro_led_blink(void) {
 void dynamic_macro_record_start(uint8_t macro_id) {
   dprintf("dynamic macro recording: started for slot %d\n", macro_id);
 
+  dynamic_macro_stop();
   dynamic_macro_led_blink();
 
   clear_keyboard();
@@ -38,25 +131,71 @@ void dynamic_macro_record_start(uint8_t macro_id) {
 }
 
 /**
- * Play the dynamic macro.
+ * Play the dynamic macro. Events are sent by dynamic_macro_task() with
+ * the recorded timing, scaled by DYNAMIC_MACRO_PLAYBACK_SPEED.
  *
  * @param macro_id[in]     The id of macro to be played
  */
 void dynamic_macro_play(uint8_t macro_id) {
   dprintf("dynamic macro: slot %d playback, length %d\n", macro_id, dynamic_macros[macro_id].length);
 
-  uint32_t saved_layer_state = layer_state;
+  dynamic_macro_stop();
+
+  playing_saved_layer_state = layer_state;
 
   clear_keyboard();
   layer_clear();
 
-  for (uint8_t i = 0; i < dynamic_macros[macro_id].length; ++i) {
-    process_record(&dynamic_macros[macro_id].events[i]);
+  playing_id   = macro_id;
+  playing_pos  = 0;
+  playing_next = timer_read32();
+}
+
+/**
+ * Stop the macro currently being played, if any.
+ */
+void dynamic_macro_stop(void) {
+  if (playing_id == 255) {
+    return;
   }
 
+  playing_id = 255;
+
   clear_keyboard();
 
-  layer_state = saved_layer_state;
+  layer_state = playing_saved_layer_state;
+}
+
+/* Play back all events that are due. Called from housekeeping. */
+void dynamic_macro_task(void) {
+  dynamic_macro_led_blink_task();
+
+  while (playing_id != 255) {
+    dynamic_macro_t* macro = &dynamic_macros[playing_id];
+    uint16_t         pos   = playing_pos;
+    keyevent_t       event;
+    uint32_t         delay;
+
+    if (!dynamic_macro_decode_event(macro, &pos, &event, &delay)) {
+      dynamic_macro_stop();
+      return;
+    }
+
+#if DYNAMIC_MACRO_PLAYBACK_SPEED > 0
+    uint32_t due = playing_next + delay * 100 / DYNAMIC_MACRO_PLAYBACK_SPEED;
+    if (!timer_expired32(timer_read32(), due)) {
+      return;
+    }
+    playing_next = due;
+#else
+    (void)delay;
+#endif
+
+    playing_pos = pos;
+
+    keyrecord_t record = {.event = event};
+    process_record(&record);
+  }
 }
 
 /**
@@ -66,23 +205,28 @@ void dynamic_macro_play(uint8_t macro_id) {
  * @param record[in]     The current keypress.
  */
 void dynamic_macro_record_key(uint8_t macro_id, keyrecord_t* record) {
-  dynamic_macro_t* macro  = &dynamic_macros[macro_id];
-  uint8_t          length = macro->length;
+  dynamic_macro_t* macro = &dynamic_macros[macro_id];
+  uint8_t          buf[DYNAMIC_MACRO_EVENT_MAX_SIZE];
+  uint32_t         now = timer_read32();
 
   /* If we've just started recording, ignore all the key releases. */
-  if (!record->event.pressed && length == 0) {
+  if (!record->event.pressed && macro->length == 0) {
     dprintln("dynamic macro: ignoring a leading key-up event");
     return;
   }
 
-  if (length < DYNAMIC_MACRO_SIZE) {
-    macro->events[length] = *record;
-    macro->length         = ++length;
+  uint32_t delay = macro->length == 0 ? 0 : TIMER_DIFF_32(now, last_event_time);
+  uint8_t  size  = dynamic_macro_encode_event(buf, &record->event, delay);
+
+  if (macro->length + size <= DYNAMIC_MACRO_BUFFER_SIZE) {
+    memcpy(&macro->data[macro->length], buf, size);
+    macro->length += size;
+    last_event_time = now;
   } else {
     dynamic_macro_led_blink();
   }
 
-  dprintf("dynamic macro: slot %d length: %d/%d\n", macro_id, length, DYNAMIC_MACRO_SIZE);
+  dprintf("dynamic macro: slot %d length: %d/%d bytes\n", macro_id, macro->length, (int)DYNAMIC_MACRO_BUFFER_SIZE);
 }
 
 /**
@@ -92,25 +236,27 @@ void dynamic_macro_record_key(uint8_t macro_id, keyrecord_t* record) {
 void dynamic_macro_record_end(uint8_t macro_id) {
   dynamic_macro_led_blink();
 
-  dynamic_macro_t* macro  = &dynamic_macros[macro_id];
-  uint8_t          length = macro->length;
-
-  keyrecord_t* events_begin   = &(macro->events[0]);
-  keyrecord_t* events_pointer = &(macro->events[length - 1]);
+  dynamic_macro_t* macro = &dynamic_macros[macro_id];
+  uint16_t         pos   = 0;
+  uint16_t         end   = 0;
+  keyevent_t       event;
+  uint32_t         delay;
 
+  /* Trim trailing key-down events, keeping everything up to the last key-up */
   dprintf("dynamic_macro: macro length before trimming: %d\n", macro->length);
-  while (events_pointer != events_begin && (events_pointer)->event.pressed) {
-    dprintln("dynamic macro: trimming a trailing key-down event");
-    --(macro->length);
-    --events_pointer;
+  while (dynamic_macro_decode_event(macro, &pos, &event, &delay)) {
+    if (!event.pressed) {
+      end = pos;
+    }
   }
+  macro->length = end;
 
 #ifdef DYNAMIC_MACRO_EEPROM_STORAGE
   macro->checksum = dynamic_macro_calc_crc(macro);
   dynamic_macro_save_eeprom(macro_id);
 #endif
 
-  dprintf("dynamic macro: slot %d saved, length: %d\n", macro_id, length);
+  dprintf("dynamic macro: slot %d saved, length: %d\n", macro_id, macro->length);
 }
 
 /* Handle the key events related to the dynamic macros. Should be
@@ -231,7 +377,7 @@ void dynamic_macro_load_eeprom(uint8_t macro_id) {
   eeprom_read_block(dst, dynamic_macro_eeprom_macro_addr(macro_id), sizeof(dynamic_macro_t));
 
   /* Validate checksum, ifchecksum is NOT valid for macro, set its length to 0 to prevent its use. */
-  if (dynamic_macro_calc_crc(dst) != dst->checksum) {
+  if (dynamic_macro_calc_crc(dst) != dst->checksum || dst->length > DYNAMIC_MACRO_BUFFER_SIZE) {
     dprintf("dynamic macro: slot %d not loaded, checksum mismatch\n", macro_id);
     dst->length = 0;
 
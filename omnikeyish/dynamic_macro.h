@@ -25,18 +25,30 @@
 #endif
 
 #ifndef DYNAMIC_MACRO_SIZE
-/* May be overridden with a custom value. Be aware that the effective
- * macro length is half of this value: each keypress is recorded twice
- * because of the down-event and up-event. This is not a bug, it's the
- * intended behavior.
- *
- * Usually it should be fine to set the macro size to at least 256 but
- * there have been reports of it being too much in some users' cases,
- * so 128 is considered a safe default.
+/* Sizes the macro buffer; kept for compatibility with the old layout
+ * that stored full keyrecord_t structs. Each slot gets the same amount
+ * of memory as DYNAMIC_MACRO_SIZE of those records, but events are now
+ * stored compactly (usually 2-3 bytes each), so several times as many
+ * key events fit. Use DYNAMIC_MACRO_BUFFER_SIZE to size it in bytes.
  */
 #define DYNAMIC_MACRO_SIZE 64
 #endif
 
+#ifndef DYNAMIC_MACRO_BUFFER_SIZE
+#define DYNAMIC_MACRO_BUFFER_SIZE (DYNAMIC_MACRO_SIZE * sizeof(keyrecord_t))
+#endif
+
+/* Playback speed in percent of the recorded timing, 0 plays back
+ * without any delays between events.
+ */
+#ifndef DYNAMIC_MACRO_PLAYBACK_SPEED
+#define DYNAMIC_MACRO_PLAYBACK_SPEED 100
+#endif
+
+#ifndef DYNAMIC_MACRO_BLINK_DURATION
+#define DYNAMIC_MACRO_BLINK_DURATION 100
+#endif
+
 #ifndef DYNAMIC_MACRO_EEPROM_STORAGE
 #define DYNAMIC_MACRO_EEPROM_STORAGE
 #endif
@@ -65,16 +77,26 @@ enum dynamic_macro_keycodes {
 
 enum dynamic_macro_recording_state { STATE_NOT_RECORDING, STATE_RECORD_KEY_PRESSED, STATE_CURRENTLY_RECORDING };
 
+/* Events are stored as:
+ *   byte 0:    row << 5 | col
+ *   byte 1..3: (delay_ms << 1 | pressed) as a little endian base-128
+ *              varint, delay being the time since the previous event
+ */
+#define DYNAMIC_MACRO_EVENT_MAX_SIZE 4
+#define DYNAMIC_MACRO_MAX_DELAY ((1UL << 20) - 1)
+
 typedef struct {
-  keyrecord_t events[DYNAMIC_MACRO_SIZE];
-  uint8_t     length;
-  uint16_t    checksum;
+  uint8_t  data[DYNAMIC_MACRO_BUFFER_SIZE];
+  uint16_t length;
+  uint16_t checksum;
 } dynamic_macro_t;
 
 void     dynamic_macro_init(void);
 void     dynamic_macro_led_blink(void);
 void     dynamic_macro_record_start(uint8_t macro_id);
 void     dynamic_macro_play(uint8_t macro_id);
+void     dynamic_macro_stop(void);
+void     dynamic_macro_task(void);
 void     dynamic_macro_record_key(uint8_t macro_id, keyrecord_t* record);
 void     dynamic_macro_record_end(uint8_t macro_id);
 bool     process_record_dynamic_macro(uint16_t keycode, keyrecord_t* record);
@@ -82,7 +104,7 @@ bool     process_record_dynamic_macro(uint16_t keycode, keyrecord_t* record);
 #define DYNAMIC_MACRO_CRC_LENGTH (sizeof(dynamic_macro_t) - sizeof(uint16_t))
 
 #ifdef DYNAMIC_MACRO_EEPROM_STORAGE
-#define DYNAMIC_MACRO_EEPROM_MAGIC (uint16_t)0xDEAD
+#define DYNAMIC_MACRO_EEPROM_MAGIC (uint16_t)0xDEAF
 
 uint16_t dynamic_macro_calc_crc(dynamic_macro_t* macro);
 void dynamic_macro_load_eeprom_all(void);
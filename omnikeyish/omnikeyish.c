@@ -25,6 +25,11 @@ void keyboard_post_init_kb(void) {
   keyboard_post_init_user();
 }
 
+void housekeeping_task_kb(void) {
+  /* Paced macro playback and LED blink timeouts */
+  dynamic_macro_task();
+}
+
 bool process_record_user(uint16_t keycode, keyrecord_t *record) {
   if (!process_record_dynamic_macro(keycode, record)) {
     return false;
@@ -16,13 +16,31 @@ void encoder_sync_slave_handler(uint8_t in_buflen, const void *in_data, uint8_t
 
 void encoder_quadrature_init_pin(uint8_t index, bool pad_b) {}
 
+// Pad A is on this half and pad B on the other one, so neither half can
+// decode the encoder by itself. Instead of a split round trip for every
+// poll, pad B is cached and only fetched again when pad A has moved since
+// the last fetch, or PICA40_ENCODER_SYNC_INTERVAL ms have passed. Pad A
+// is read before pad B, and the two pads never change together, so an A
+// edge always sees the B level it needs.
+static uint8_t  encoder_pin_a      = 0;
+static uint8_t  encoder_pin_b      = 0;
+static uint8_t  encoder_synced_a   = 0xFF;
+static uint16_t encoder_sync_timer = 0;
+
 uint8_t encoder_quadrature_read_pin(uint8_t index, bool pad_b) {
     if(pad_b) {
-        uint8_t data = 0;
-        transaction_rpc_recv(ENCODER_SYNC, sizeof(data), &data);
-        return data;
+        if (encoder_pin_a != encoder_synced_a || timer_elapsed(encoder_sync_timer) >= PICA40_ENCODER_SYNC_INTERVAL) {
+            uint8_t data = 0;
+            if (transaction_rpc_recv(ENCODER_SYNC, sizeof(data), &data)) {
+                encoder_pin_b    = data;
+                encoder_synced_a = encoder_pin_a;
+            }
+            encoder_sync_timer = timer_read();
+        }
+        return encoder_pin_b;
     }
-    return gpio_read_pin(ENCODER_PIN_A) ? 1 : 0;
+    encoder_pin_a = gpio_read_pin(ENCODER_PIN_A) ? 1 : 0;
+    return encoder_pin_a;
 }
 
 #endif // ENCODER_ENABLE
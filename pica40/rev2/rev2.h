@@ -16,4 +16,7 @@
 #   ifndef ENCODER_MAP_KEY_DELAY
 #       define ENCODER_MAP_KEY_DELAY 2
 #   endif
+#   ifndef PICA40_ENCODER_SYNC_INTERVAL
+#       define PICA40_ENCODER_SYNC_INTERVAL 1 // ms between pad B fetches while pad A is idle
+#   endif
 #endif
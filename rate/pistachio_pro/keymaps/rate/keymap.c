@@ -55,13 +55,13 @@ const char code_to_name[60] = {
 
 static void print_airstate(void) {
     char airstate_str[32];
-    double temp;
-    double press;
-    double hum;
+    int32_t temp;
+    uint32_t press;
+    uint32_t hum;
 
-    temp = bme280_getTemp();
-    press = bme280_getPress();
-    hum = bme280_getHum();
+    temp = bme280_getTemperature() / 100;
+    press = bme280_getPressure() / 100;
+    hum = bme280_getHumidity() >> 10;
 
     oled_write_ln_P(PSTR("\nTemp   Press    Hum"), false);
     snprintf(airstate_str, sizeof(airstate_str), "%ddeg  %dhPa  %d%% \n", (int)temp, (int)press, (int)hum );
@@ -16,6 +16,7 @@
 #include <stdint.h>
 #include "bme280.h"
 #include "i2c_master.h"
+#include "timer.h"
 
 #define BME280_ADDRESS (0x76<<1)
 
@@ -29,6 +30,15 @@
 
 #define I2C_BME280_TIMEOUT (20)
 
+/* Time between measurements [ms] */
+#ifndef BME280_UPDATE_INTERVAL
+#    define BME280_UPDATE_INTERVAL (1000)
+#endif
+
+/* Maximum measurement time with x1 oversampling on all three channels,
+ * 1.25 + 2.3 + (2.3 + 0.575) * 2 = 9.3ms, rounded up [ms] */
+#define BME280_MEASURE_TIME (10)
+
 /* BME280 configurator values */
 /* [2:0]         Humidity oversampling
  * 000           Skipped
@@ -57,9 +67,11 @@
  * 101,others    oversampling x16
  * [1:0]         Mode
  * 00            Sleep mode
+ * 01            Forced mode
  * 11            Normal mode
  */
-#define BME280_CTRL_MEAS_VAL (0x27)
+#define BME280_CTRL_MEAS_VAL (0x24)
+#define BME280_MODE_FORCED (0x01)
 
 /* [7:5]        t_standby[ms]
  * 000          0.5
@@ -82,13 +94,25 @@
  */
 #define BME280_CONFIG_VAL (0xA0)
 
+/* Measurements run in forced mode from bme280_exec(), one short I2C
+ * transfer per call, so the keyboard loop never waits for a conversion */
+typedef enum {
+    BME280_STATE_IDLE,
+    BME280_STATE_MEASURING,
+} bme280_state_t;
+
 static void readTrim(void);
-static void readData(void);
+static bool readData(void);
 static int32_t calibration_T(int32_t adc_T);
 static uint32_t calibration_P(int32_t adc_P);
 static uint32_t calibration_H(int32_t adc_H);
 
 static uint32_t hum_raw,temp_raw,pres_raw;
+static bme280_state_t state;
+static uint16_t state_timer;
+static bool has_data;
+static int32_t temp_cal;
+static uint32_t press_cal, hum_cal;
 static uint16_t dig_T1;
 static int16_t dig_T2, dig_T3;
 static uint16_t dig_P1;
@@ -103,7 +127,7 @@ static void readTrim(void) {
     uint8_t data[32];
 
     i2c_read_register(BME280_ADDRESS, BME280_REG_CALIB00, &data[0], 24, I2C_BME280_TIMEOUT);
-    i2c_read_register(BME280_ADDRESS, BME280_REG_CALIB25, &data[25], 1, I2C_BME280_TIMEOUT);
+    i2c_read_register(BME280_ADDRESS, BME280_REG_CALIB25, &data[24], 1, I2C_BME280_TIMEOUT);
     i2c_read_register(BME280_ADDRESS, BME280_REG_CALIB26, &data[25], 7, I2C_BME280_TIMEOUT);
 
     dig_T1 = (data[1] << 8) | data[0];
@@ -128,10 +152,12 @@ static void readTrim(void) {
     return;
 }
 
-static void readData(void) {
+static bool readData(void) {
     uint8_t data[8];
 
-    i2c_read_register(BME280_ADDRESS, 0xF7, &data[0], 8, I2C_BME280_TIMEOUT);
+    if (i2c_read_register(BME280_ADDRESS, BME280_REG_PRESS_MSB, &data[0], 8, I2C_BME280_TIMEOUT) != I2C_STATUS_SUCCESS) {
+        return false;
+    }
 
     pres_raw = data[0];
     pres_raw = (pres_raw<<8) | data[1];
@@ -144,7 +170,7 @@ static void readData(void) {
     hum_raw  = data[6];
     hum_raw  = (hum_raw << 8) | data[7];
 
-    return;
+    return true;
 }
 
 static int32_t calibration_T(int32_t adc_T) {
@@ -215,41 +241,61 @@ void bme280_init(void) {
     i2c_write_register(BME280_ADDRESS, BME280_REG_CONFIG, &config_reg, 1, I2C_BME280_TIMEOUT);
     readTrim();
 
+    state = BME280_STATE_IDLE;
+    /* Take the first measurement right away */
+    state_timer = timer_read() - BME280_UPDATE_INTERVAL;
+    has_data = false;
+
     return;
 }
 
 void bme280_exec(void) {
-    readData();
+    uint8_t ctrl_meas_reg;
+
+    switch (state) {
+        case BME280_STATE_IDLE:
+            if (timer_elapsed(state_timer) < BME280_UPDATE_INTERVAL) {
+                break;
+            }
+            /* Trigger a single measurement, the sensor goes back to sleep after it */
+            ctrl_meas_reg = BME280_CTRL_MEAS_VAL | BME280_MODE_FORCED;
+            state_timer = timer_read();
+            if (i2c_write_register(BME280_ADDRESS, BME280_REG_CTRL_MEAS, &ctrl_meas_reg, 1, I2C_BME280_TIMEOUT) == I2C_STATUS_SUCCESS) {
+                state = BME280_STATE_MEASURING;
+            }
+            break;
+
+        case BME280_STATE_MEASURING:
+            if (timer_elapsed(state_timer) < BME280_MEASURE_TIME) {
+                break;
+            }
+            /* Burst read all results and compensate them once; the temperature
+             * goes first since it sets t_fine for the other two */
+            if (readData()) {
+                temp_cal = calibration_T(temp_raw);
+                press_cal = calibration_P(pres_raw);
+                hum_cal = calibration_H(hum_raw);
+                has_data = true;
+            }
+            state = BME280_STATE_IDLE;
+            break;
+    }
 
     return;
 }
 
-double bme280_getTemp(void) {
-    double temp_act;
-    int32_t temp_cal;
-
-    temp_cal = calibration_T(temp_raw);
-    temp_act = (double)temp_cal / 100.0;
-
-    return temp_act;
+bool bme280_hasData(void) {
+    return has_data;
 }
 
-double bme280_getPress(void) {
-    double press_act;
-    uint32_t press_cal;
-
-    press_cal = calibration_P(pres_raw);
-    press_act = (double)press_cal / 100.0;
-
-    return press_act;
+int32_t bme280_getTemperature(void) {
+    return temp_cal;
 }
 
-double bme280_getHum(void) {
-    double hum_act;
-    uint32_t hum_cal;
-
-    hum_cal = calibration_H(hum_raw);
-    hum_act = (double)hum_cal / 1024.0;
+uint32_t bme280_getPressure(void) {
+    return press_cal;
+}
 
-    return hum_act;
+uint32_t bme280_getHumidity(void) {
+    return hum_cal;
 }
@@ -15,8 +15,15 @@
  */
 #pragma once
 
+#include <stdint.h>
+#include <stdbool.h>
+
 void bme280_init(void);
+/* Call from the main loop; runs the next step of the measurement cycle */
 void bme280_exec(void);
-double bme280_getTemp(void);
-double bme280_getPress(void);
-double bme280_getHum(void);
+
+/* Latest cached measurement, updated every BME280_UPDATE_INTERVAL ms */
+bool bme280_hasData(void);
+int32_t bme280_getTemperature(void); /* 0.01 degC */
+uint32_t bme280_getPressure(void);   /* Pa */
+uint32_t bme280_getHumidity(void);   /* 1/1024 %RH */
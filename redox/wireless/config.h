@@ -21,3 +21,8 @@
 #define MATRIX_COLS 14
 
 #define ONESHOT_TIMEOUT 500
+
+/* receiver bridge frame */
+#define WIRELESS_FRAME_SIZE 11
+#define WIRELESS_FRAME_END 10
+#define WIRELESS_ROW_SHIFT 7
@@ -42,6 +42,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #define ANALOG_PORT F6
 #define MUX_SEL_PINS { D1, D0, D4 }
 
+/* calibrated thresholds, 4 bytes per key of this half */
+#define EECONFIG_KB_DATA_SIZE 160
+
+/* calibration keycodes are forwarded to the other half */
+#define SPLIT_TRANSACTION_IDS_KB EC_CALIBRATION_SYNC
+
 /* COL2ROW, ROW2COL */
 #define DIODE_DIRECTION COL2ROW
 
@@ -14,7 +14,20 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
 #include "grs_70ec.h"
+#include "ec.h"
+#include "transactions.h"
+
+// calibration keycode waiting to run on the slave half
+static uint16_t pending_ec_keycode = KC_NO;
+
+// runs from the split link, the calibration itself needs the ADC interrupt
+static void ec_calibration_slave_handler(uint8_t m2s_size, const void *m2s_buffer, uint8_t s2m_size, void *s2m_buffer) {
+    if (m2s_size == sizeof(pending_ec_keycode)) {
+        memcpy(&pending_ec_keycode, m2s_buffer, m2s_size);
+    }
+}
 
 void led_on(void) {
     gpio_set_pin_output(D2);
@@ -25,6 +38,7 @@ void led_off(void) { gpio_write_pin_low(D2); }
 
 void keyboard_post_init_kb(void) {
     led_on();
+    transaction_register_rpc(EC_CALIBRATION_SYNC, ec_calibration_slave_handler);
 
     keyboard_post_init_user();
 }
@@ -36,3 +50,22 @@ void keyboard_pre_init_kb(void) {
 
     keyboard_pre_init_user();
 }
+
+void housekeeping_task_kb(void) {
+    if (pending_ec_keycode != KC_NO) {
+        keyrecord_t record = {.event.pressed = false};
+        process_record_ec(pending_ec_keycode, &record);
+        pending_ec_keycode = KC_NO;
+    }
+}
+
+bool process_record_kb(uint16_t keycode, keyrecord_t *record) {
+    if (!process_record_user(keycode, record)) {
+        return false;
+    }
+    // each half keeps its own thresholds, so the other one is told as well
+    if ((keycode == EC_CALIBRATE || keycode == EC_CALIBRATE_RESET) && !record->event.pressed) {
+        transaction_rpc_send(EC_CALIBRATION_SYNC, sizeof(keycode), &keycode);
+    }
+    return process_record_ec(keycode, record);
+}
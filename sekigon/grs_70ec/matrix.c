@@ -16,7 +16,7 @@
 
 #include "grs_70ec.h"
 
-#include "ec_switch_matrix.h"
+#include "ec.h"
 #include "matrix.h"
 #include "debug.h"
 #include "split_util.h"
@@ -48,9 +48,9 @@ __attribute__((weak)) void matrix_slave_scan_user(void) {}
 void matrix_init_custom(void) {
     split_pre_init();
 
-    ecsm_config_t ecsm_config = {.low_threshold = LOW_THRESHOLD, .high_threshold = HIGH_THRESHOLD};
+    ec_threshold_t ec_defaults = {.reset_pt = LOW_THRESHOLD, .actuation_pt = HIGH_THRESHOLD};
 
-    ecsm_init(&ecsm_config);
+    ec_init(&ec_defaults);
 
     thisHand = isLeftHand ? 0 : (ROWS_PER_HAND);
     thatHand = ROWS_PER_HAND - thisHand;
@@ -59,12 +59,13 @@ void matrix_init_custom(void) {
 }
 
 bool matrix_scan_custom(matrix_row_t current_matrix[]) {
-    bool updated = ecsm_matrix_scan(current_matrix);
+    bool updated = ec_matrix_scan(current_matrix);
 
-    static int cnt = 0;
-    if (cnt++ == 300) {
-        cnt = 0;
-        ecsm_print_matrix();
+    // pace the dump by time, the matrix is read far more often than it is sampled
+    static uint16_t print_timer = 0;
+    if (timer_elapsed(print_timer) > 2000) {
+        print_timer = timer_read();
+        ec_print_matrix();
         print("\n");
     }
 
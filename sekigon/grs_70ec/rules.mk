@@ -2,4 +2,5 @@ CUSTOM_MATRIX = lite
 
 ANALOG_DRIVER_REQUIRED = yes
 
-SRC += ec_switch_matrix.c matrix.c
+VPATH += keyboards/lib/ec
+SRC += ec.c matrix.c
@@ -1,7 +1,8 @@
 CUSTOM_MATRIX = lite
 
 # project specific files
-SRC += matrix.c
+SRC += matrix.c wireless_receiver.c
+VPATH += keyboards/lib/wireless_receiver
 UART_DRIVER_REQUIRED = yes
 
 DEFAULT_FOLDER = sirius/uni660/rev2/ansi
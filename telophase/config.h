@@ -24,6 +24,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #define ONESHOT_TIMEOUT 500
 
+/* receiver bridge frame */
+#define WIRELESS_FRAME_SIZE 13
+#define WIRELESS_FRAME_END 11
+#define WIRELESS_ROW_SHIFT 6
+
 /*
  * Feature disable options
  *  These options are also useful to firmware size reduction.
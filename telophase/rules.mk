@@ -1,5 +1,6 @@
 CUSTOM_MATRIX = lite
-SRC += matrix.c
+SRC += matrix.c wireless_receiver.c
+VPATH += keyboards/lib/wireless_receiver
 UART_DRIVER_REQUIRED = yes
 
 # Disable unsupported hardware
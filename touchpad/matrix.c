@@ -29,17 +29,24 @@ SOFTWARE.
 #define VIBRATE_LENGTH 50 //Defines number of interrupts motor will vibrate for, must be bigger than 8 for correct operation
 volatile uint8_t vibrate = 0; //Trigger vibration in interrupt
 
-static matrix_row_t matrix[MATRIX_ROWS];
+//Keep the keyboard responsive if the touch IC stops answering, a failed read is retried on the next scan
+#ifndef TOUCH_I2C_TIMEOUT
+#  define TOUCH_I2C_TIMEOUT 5
+#endif
+
+#define TOUCH_ADDRESS (0x1C << 1)
+#define TOUCH_REG_STATUS 0x02 //Detection status, key status 0-7, key status 8-11, slider
 
 const uint8_t SENr[6] = {1, 2, 3, 5, 6, 7};//Maps capacitive pads to pins
 const uint8_t SENc[6] = {0, 4, 8, 9, 10, 11};
 
-volatile uint8_t LEDs[6][6] = {{0}};//Stores current LED values
+static const pin_t led_row_pins[6] = {D6, B4, B5, B6, C6, C7};
+static const pin_t led_col_pins[6] = {F5, F4, F1, F0, F6, F7};
 
 //Read data from the cap touch IC
 uint8_t readDataFromTS(uint8_t reg) {
   uint8_t rx[1] = { 0 };
-  if (i2c_read_register(0x1C << 1, reg, rx, 1, 100) == 0) {
+  if (i2c_read_register(TOUCH_ADDRESS, reg, rx, 1, TOUCH_I2C_TIMEOUT) == 0) {
     return rx[0];
   }
   return 0;
@@ -48,7 +55,7 @@ uint8_t readDataFromTS(uint8_t reg) {
 //Write data to cap touch IC
 uint8_t writeDataToTS(uint8_t reg, uint8_t data) {
   uint8_t tx[2] = { reg, data };
-  if (i2c_transmit(0x1C << 1, tx, 2, 100) == 0) {
+  if (i2c_transmit(TOUCH_ADDRESS, tx, 2, TOUCH_I2C_TIMEOUT) == 0) {
     return 1;
   } else {
     return 0;
@@ -106,23 +113,7 @@ uint8_t capSetup(void) {
   return temp_return;
 }
 
-__attribute__ ((weak))
-void matrix_init_user(void) {}
-
-__attribute__ ((weak))
-void matrix_scan_user(void) {}
-
-__attribute__ ((weak))
-void matrix_init_kb(void) {
-  matrix_init_user();
-}
-
-__attribute__ ((weak))
-void matrix_scan_kb(void) {
-  matrix_scan_user();
-}
-
-void matrix_init(void) {
+void matrix_init_custom(void) {
 
   i2c_init();
 
@@ -135,122 +126,136 @@ void matrix_init(void) {
   gpio_set_pin_output(B7);
   gpio_write_pin_high(B7);
 
-  //LEDs Columns
-  gpio_set_pin_output(F7);
-  gpio_set_pin_output(F6);
-  gpio_set_pin_output(F5);
-  gpio_set_pin_output(F4);
-  gpio_set_pin_output(F1);
-  gpio_set_pin_output(F0);
-
-  //LEDs Rows
-  gpio_set_pin_output(D6);
-  gpio_set_pin_output(B4);
-  gpio_set_pin_output(B5);
-  gpio_set_pin_output(B6);
-  gpio_set_pin_output(C6);
-  gpio_set_pin_output(C7);
+  //LEDs Rows and Columns, all off
+  for (uint8_t i = 0; i < 6; i++) {
+    gpio_set_pin_output(led_row_pins[i]);
+    gpio_write_pin_low(led_row_pins[i]);
+    gpio_set_pin_output(led_col_pins[i]);
+    gpio_write_pin_high(led_col_pins[i]);
+  }
 
   //Capacitive Interrupt
   gpio_set_pin_input(D2);
 
   capSetup();
   writeDataToTS(0x06, 0x12); //Calibrate capacitive touch IC
-
-  memset(matrix, 0, MATRIX_ROWS * sizeof(matrix_row_t));
-
-  matrix_init_kb();
 }
 
+//Read all status registers in one transfer, which also releases the change line
+bool touchDetectionRoutine(uint16_t *data) {
+  uint8_t rx[4];
+  if (i2c_read_register(TOUCH_ADDRESS, TOUCH_REG_STATUS, rx, sizeof(rx), TOUCH_I2C_TIMEOUT) != 0) {
+    return false;
+  }
+  *data = ((uint16_t)rx[2] << 8) | rx[1];
+  return true;
+}
 
-uint16_t touchDetectionRoutine(void) {
-  uint16_t data;
-  uint8_t temp1, temp2;
-
-  temp1 = readDataFromTS(0x04);
-  temp2 = readDataFromTS(0x03);
-  data = temp1;
-  data = (data << 8) | temp2;
-  return data;
-
+//Process raw capacitive data into bitmaps of touched rows and columns
+void decodeArray(uint16_t dataIn, uint8_t *columns, uint8_t *rows) {
+  *columns = 0;
+  *rows = 0;
+  for (uint8_t j = 0; j < 6; j++) {
+    if (dataIn & (1 << SENr[j])) {
+      *rows |= 1 << j;
+    }
+    if (dataIn & (1 << SENc[j])) {
+      *columns |= 1 << j;
+    }
+  }
 }
 
-//Process raw capacitive data, map pins to rows and columns
-void decodeArray(uint16_t dataIn, uint8_t *column, uint8_t *row) {
-  uint8_t i1 = 20, i2 = 20;
-  for (uint8_t i = 0; i < 12; i++) {
-    if ((dataIn & 0b1) == 1) {
-      if (i1 == 20) {
-        i1 = i;
-      } else if (i2 == 20) {
-        i2 = i;
+//Turn touched rows and columns into key presses. Every touched row and column
+//pair is a candidate, which is exact as long as only one row or only one
+//column is touched. Otherwise held keys that are still candidates stay down,
+//and a new key is only added when it is the one row and column they don't
+//account for, so chords pressed one key at a time resolve.
+void resolveTouches(uint8_t columns, uint8_t rows, matrix_row_t current_matrix[]) {
+  uint8_t row_count = __builtin_popcount(rows);
+  uint8_t column_count = __builtin_popcount(columns);
+  uint8_t held_rows = 0, held_columns = 0;
+
+  for (uint8_t r = 0; r < 6; r++) {
+    if (!(rows & (1 << r))) {
+      current_matrix[r] = 0;
+    } else if (row_count == 1 || column_count == 1) {
+      current_matrix[r] = columns;
+    } else {
+      current_matrix[r] &= columns;
+      if (current_matrix[r]) {
+        held_rows |= 1 << r;
+        held_columns |= current_matrix[r];
       }
     }
-    dataIn = dataIn >> 1;
   }
 
-  for (uint8_t j = 0; j < 6; j++) {
-    if (SENr[j] == i1 || SENr[j] == i2) {
-      *row = j;
-    }
-    if (SENc[j] == i1 || SENc[j] == i2) {
-      *column = j;
+  if (row_count > 1 && column_count > 1) {
+    uint8_t new_rows = rows & ~held_rows;
+    uint8_t new_columns = columns & ~held_columns;
+    if (__builtin_popcount(new_rows) == 1 && __builtin_popcount(new_columns) == 1) {
+      current_matrix[__builtin_ctz(new_rows)] |= new_columns;
     }
   }
 }
 
-void touchClearCurrentDetections(void) {
-  readDataFromTS(0x05);
-  readDataFromTS(0x02);
-  readDataFromTS(0x03);
-  readDataFromTS(0x04);
-}
-
 //Check interrupt pin
 uint8_t isTouchChangeDetected(void) {
   return !gpio_read_pin(D2);
 }
 
-uint8_t matrix_scan(void) {
-  if (isTouchChangeDetected()) {
-    uint16_t dataIn = touchDetectionRoutine();
-    if ((dataIn & 0b111100010001) > 0 && (dataIn & 0b000011101110) > 0) {
-      uint8_t column = 10, row = 10;
-      decodeArray(dataIn, &column, &row);
-      if (column != 10 && row != 10) {
-        vibrate = VIBRATE_LENGTH; //Trigger vibration
-        matrix[row] = _BV(column);
-      } else {
-        memset(matrix, 0, MATRIX_ROWS * sizeof(matrix_row_t));
-      }
-    } else {
-      memset(matrix, 0, MATRIX_ROWS * sizeof(matrix_row_t));
-    }
-    touchClearCurrentDetections();
+//Multiplex the LED grid one lit row per scan, pins are only written when the
+//row or its pattern differs from what is already being shown
+void updateLEDs(matrix_row_t current_matrix[]) {
+  static uint8_t shown_row = 0;
+  static matrix_row_t shown_columns = 0;
+
+  uint8_t row = shown_row;
+  for (uint8_t i = 0; i < 6; i++) {
+    row = (row + 1) % 6;
+    if (current_matrix[row]) break;
   }
+  matrix_row_t columns = current_matrix[row];
 
+  if (row == shown_row && columns == shown_columns) {
+    return;
+  }
+
+  gpio_write_pin_low(led_row_pins[shown_row]);
   for (uint8_t c = 0; c < 6; c++) {
-    for (uint8_t r = 0; r < 6; r++) {
-      switch (r) {
-        case 0: gpio_write_pin(D6, matrix_is_on(r, c)); break;
-        case 1: gpio_write_pin(B4, matrix_is_on(r, c)); break;
-        case 2: gpio_write_pin(B5, matrix_is_on(r, c)); break;
-        case 3: gpio_write_pin(B6, matrix_is_on(r, c)); break;
-        case 4: gpio_write_pin(C6, matrix_is_on(r, c)); break;
-        case 5: gpio_write_pin(C7, matrix_is_on(r, c)); break;
-      }
+    if ((columns ^ shown_columns) & (1 << c)) {
+      gpio_write_pin(led_col_pins[c], !(columns & (1 << c)));
+    }
+  }
+  gpio_write_pin(led_row_pins[row], columns != 0);
+
+  shown_row = row;
+  shown_columns = columns;
+}
+
+bool matrix_scan_custom(matrix_row_t current_matrix[]) {
+  bool changed = false;
 
-      switch (c) {
-        case 0: gpio_write_pin(F5, !matrix_is_on(r, c)); break;
-        case 1: gpio_write_pin(F4, !matrix_is_on(r, c)); break;
-        case 2: gpio_write_pin(F1, !matrix_is_on(r, c)); break;
-        case 3: gpio_write_pin(F0, !matrix_is_on(r, c)); break;
-        case 4: gpio_write_pin(F6, !matrix_is_on(r, c)); break;
-        case 5: gpio_write_pin(F7, !matrix_is_on(r, c)); break;
+  if (isTouchChangeDetected()) {
+    uint16_t dataIn;
+    if (touchDetectionRoutine(&dataIn)) {
+      matrix_row_t previous[MATRIX_ROWS];
+      uint8_t columns, rows;
+
+      memcpy(previous, current_matrix, sizeof(previous));
+      decodeArray(dataIn, &columns, &rows);
+      resolveTouches(columns, rows, current_matrix);
+
+      for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
+        if (current_matrix[r] & ~previous[r]) {
+          vibrate = VIBRATE_LENGTH; //Trigger vibration
+        }
       }
+      changed = memcmp(previous, current_matrix, sizeof(previous)) != 0;
     }
   }
 
+  updateLEDs(current_matrix);
+
   if (vibrate == VIBRATE_LENGTH) {
     gpio_write_pin_high(E6);
     gpio_write_pin_high(D7);
@@ -262,31 +267,5 @@ uint8_t matrix_scan(void) {
     gpio_write_pin_low(E6);
   }
 
-  matrix_scan_kb();
-
-  return 1;
-
-}
-
-bool matrix_is_on(uint8_t row, uint8_t col) {
-    return (matrix[row] & (1<<col));
-}
-
-matrix_row_t matrix_get_row(uint8_t row) {
-    return matrix[row];
-}
-
-void matrix_print(void) {
-    xprintf("\nr/c 01234567\n");
-    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
-        xprintf("%X0: ", row);
-        matrix_row_t data = matrix_get_row(row);
-        for (int col = 0; col < MATRIX_COLS; col++) {
-            if (data & (1<<col))
-                xprintf("1");
-            else
-                xprintf("0");
-        }
-        xprintf("\n");
-    }
+  return changed;
 }
@@ -1,4 +1,4 @@
-CUSTOM_MATRIX = yes
+CUSTOM_MATRIX = lite
 
 SRC += matrix.c
 I2C_DRIVER_REQUIRED = yes
@@ -39,12 +39,12 @@ void board_init(void) {
 // Initialisation
 
 void keyboard_post_init_kb(void) {
-    // Register keyboard state sync split transaction
-    transaction_register_rpc(RPC_ID_SYNC_STATE_KB, kb_state_sync_slave);
-
     // Reset the initial shared data value between master and slave
     memset(&kb_state, 0, sizeof(kb_state));
 
+    // Register keyboard state sync split transaction
+    kb_state_sync_init();
+
     // Turn off increased current limits
     gpio_set_pin_output(RGB_CURR_1500mA_OK_PIN);
     gpio_write_pin_low(RGB_CURR_1500mA_OK_PIN);
@@ -27,5 +27,5 @@ typedef struct kb_runtime_config {
 extern kb_runtime_config kb_state;
 
 void kb_state_update(void);
+void kb_state_sync_init(void);
 void kb_state_sync(void);
-void kb_state_sync_slave(uint8_t m2s_size, const void* m2s_buffer, uint8_t s2m_size, void* s2m_buffer);
@@ -7,6 +7,8 @@
 #define GPIOB_COUNT 3
 #define GPIOC_BITMASK (1 << 6 | 1 << 7 | 1 << 8) // C6, C7, C8
 #define GPIOC_OFFSET 6
+#define GPIOC_COUNT 3
+#define ROW_BITMASK ((1 << (GPIOB_COUNT + GPIOC_COUNT)) - 1) // rows of one half
 
 // Pin definitions
 static const pin_t row_pins[MATRIX_ROWS] = MATRIX_ROW_PINS;
@@ -49,7 +51,15 @@ void matrix_init_custom(void) {
 }
 
 bool matrix_scan_custom(matrix_row_t current_matrix[]) {
-    static matrix_row_t temp_matrix[MATRIX_ROWS] = {0};
+    // Last readback of each column, so unchanged columns skip the matrix update entirely
+    static uint8_t col_state[MATRIX_COLS] = {0};
+    bool           changed                = false;
+
+#ifdef DJINN_MATRIX_SCAN_TIMING
+    static uint32_t scan_cycles = 0;
+    static uint32_t scan_count  = 0;
+    rtcnt_t         scan_start  = chSysGetRealtimeCounterX();
+#endif
 
     for (int current_col = 0; current_col < MATRIX_COLS; ++current_col) {
         // Keep track of the pin we're working with
@@ -68,30 +78,40 @@ bool matrix_scan_custom(matrix_row_t current_matrix[]) {
         gpio_set_pin_input_high(curr_col_pin);
 
         // Construct the packed bitmask for the pins
-        uint32_t readback = ~(((gpio_b & GPIOB_BITMASK) >> GPIOB_OFFSET) | (((gpio_c & GPIOC_BITMASK) >> GPIOC_OFFSET) << GPIOB_COUNT));
-
-        // Inject values into the matrix
-        for (int i = 0; i < MATRIX_ROWS; ++i) {
-            if (readback & (1 << i)) {
-                temp_matrix[i] |= (1ul << current_col);
-            } else {
-                temp_matrix[i] &= ~(1ul << current_col);
+        uint8_t readback = ~(((gpio_b & GPIOB_BITMASK) >> GPIOB_OFFSET) | (((gpio_c & GPIOC_BITMASK) >> GPIOC_OFFSET) << GPIOB_COUNT)) & ROW_BITMASK;
+
+        // Inject only the rows that changed into the matrix
+        uint8_t diff = readback ^ col_state[current_col];
+        if (diff) {
+            col_state[current_col] = readback;
+            changed                = true;
+            for (int i = 0; diff; ++i, diff >>= 1) {
+                if (diff & 1) {
+                    current_matrix[i] ^= (1ul << current_col);
+                }
             }
         }
 
-        // Wait for readback of the unselected column to go high
-        matrix_wait_for_pin(curr_col_pin, 1);
+        // Nothing pulled the rows low if no key is down, so only wait for the release otherwise
+        if (readback) {
+            // Wait for readback of the unselected column to go high
+            matrix_wait_for_pin(curr_col_pin, 1);
 
-        // Wait for readback of each port to go high -- unselecting the row would have been completed
-        matrix_wait_for_port(GPIOB, GPIOB_BITMASK);
-        matrix_wait_for_port(GPIOC, GPIOC_BITMASK);
+            // Wait for readback of each port to go high -- unselecting the row would have been completed
+            matrix_wait_for_port(GPIOB, GPIOB_BITMASK);
+            matrix_wait_for_port(GPIOC, GPIOC_BITMASK);
+        }
     }
 
-    // Check if we've changed, return the last-read data
-    bool changed = memcmp(current_matrix, temp_matrix, sizeof(temp_matrix)) != 0;
-    if (changed) {
-        memcpy(current_matrix, temp_matrix, sizeof(temp_matrix));
+#ifdef DJINN_MATRIX_SCAN_TIMING
+    scan_cycles += chSysGetRealtimeCounterX() - scan_start;
+    if (++scan_count == 1000) {
+        dprintf("matrix scan: %lu cycles avg\n", (unsigned long)(scan_cycles / scan_count));
+        scan_cycles = 0;
+        scan_count  = 0;
     }
+#endif
+
     return changed;
 }
 
@@ -4,9 +4,12 @@ CIE1931_CURVE = yes
 
 QUANTUM_PAINTER_DRIVERS = ili9341_spi
 
+VPATH += keyboards/lib/split_sync
+
 SRC += \
 	djinn_portscan_matrix.c \
 	djinn_split_sync.c \
-	djinn_usbpd.c
+	djinn_usbpd.c \
+	split_sync.c
 
 DEFAULT_FOLDER = tzarc/djinn/rev2
@@ -29,9 +29,9 @@
 }*/
 
 void matrix_init_custom(void) {
-    ec_config_t ec_config = {.reset_pt = RESET_PT, .actuation_pt = ACTUATION_PT};
+    ec_threshold_t ec_defaults = {.reset_pt = RESET_PT, .actuation_pt = ACTUATION_PT};
 
-    ec_init(&ec_config);
+    ec_init(&ec_defaults);
 }
 
 bool matrix_scan_custom(matrix_row_t current_matrix[]) {
@@ -41,9 +41,31 @@ bool matrix_scan_custom(matrix_row_t current_matrix[]) {
     /*static int cnt = 0;
     if (cnt++ == 300) {
         cnt = 0;
-        ec_dprint_matrix();
+        ec_print_matrix();
         dprintf("\n");
     }*/
 
     return updated;
 }
+
+bool process_record_kb(uint16_t keycode, keyrecord_t *record) {
+    if (!process_record_user(keycode, record)) {
+        return false;
+    }
+    return process_record_ec(keycode, record);
+}
+
+// Modifying threshold values for overlapping pads
+void ec_threshold_kb(uint8_t row, uint8_t col, ec_threshold_t *threshold) {
+    switch (row) {
+        case 3:
+            switch (col) {
+                case 1:
+                case 10: // lower threshold for bottom outside mods (40 rest, 50 act, 58 btm)
+                    threshold->reset_pt     = 45;
+                    threshold->actuation_pt = 50;
+                    break;
+            }
+            break;
+    }
+}
@@ -1,4 +1,5 @@
 CUSTOM_MATRIX = lite
+VPATH += keyboards/lib/ec
 SRC += ec.c
 
 ANALOG_DRIVER_REQUIRED = yes
@@ -1,4 +1,4 @@
-/* Copyright 2022 HorrorTroll <https://github.com/HorrorTroll>
+/* Copyright 2023 Viktus Design LLC
  *
  * This program is free software: you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -16,4 +16,11 @@
 
 #pragma once
 
-void render_bongocat(void);
+/* analog connection settings */
+#define DISCHARGE_PIN D3
+#define ANALOG_PORT D4
+#define MUX_SEL_PINS \
+    { D0, D1, D2 }
+
+/* calibrated thresholds, 4 bytes per key */
+#define EECONFIG_KB_DATA_SIZE 320
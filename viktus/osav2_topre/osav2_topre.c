@@ -29,9 +29,9 @@
 }*/
 
 void matrix_init_custom(void) {
-    ec_config_t ec_config = {.reset_pt = RESET_PT, .actuation_pt = ACTUATION_PT};
+    ec_threshold_t ec_defaults = {.reset_pt = RESET_PT, .actuation_pt = ACTUATION_PT};
 
-    ec_init(&ec_config);
+    ec_init(&ec_defaults);
 }
 
 bool matrix_scan_custom(matrix_row_t current_matrix[]) {
@@ -41,9 +41,57 @@ bool matrix_scan_custom(matrix_row_t current_matrix[]) {
     /*static int cnt = 0;
     if (cnt++ == 300) {
         cnt = 0;
-        ec_dprint_matrix();
+        ec_print_matrix();
         dprintf("\n");
     }*/
 
     return updated;
 }
+
+bool process_record_kb(uint16_t keycode, keyrecord_t *record) {
+    if (!process_record_user(keycode, record)) {
+        return false;
+    }
+    return process_record_ec(keycode, record);
+}
+
+// Modifying threshold values for overlapping pads
+void ec_threshold_kb(uint8_t row, uint8_t col, ec_threshold_t *threshold) {
+    switch (row) {
+        case 0:
+            switch (col) {
+                case 14: // lower threshold for split backspace: left 1U
+                case 15: // lower threshold for 2U backspace: 2U
+                    threshold->reset_pt     = 48;
+                    threshold->actuation_pt = 53;
+                    break;
+            }
+            break;
+        case 3:
+            switch (col) {
+                case 14: // Lower threshold for right shift: 1.75U
+                    threshold->reset_pt     = 48;
+                    threshold->actuation_pt = 53;
+                    break;
+            }
+            break;
+        case 4:
+            switch (col) {
+                case 3: // Lower threshold for left space: col3
+                case 4: // Lower threshold for left space: col4
+                    threshold->reset_pt     = 50;
+                    threshold->actuation_pt = 60;
+                    break;
+                case 5: // Lower threshold for left space: col5
+                case 6: // Lower threshold for left space: col6
+                    threshold->reset_pt     = 48;
+                    threshold->actuation_pt = 58;
+                    break;
+                case 14: // Lower threshold for right shift: 2.75U
+                    threshold->reset_pt     = 48;
+                    threshold->actuation_pt = 53;
+                    break;
+            }
+            break;
+    }
+}
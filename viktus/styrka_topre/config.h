@@ -14,18 +14,13 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <stdint.h>
-#include <stdbool.h>
+#pragma once
 
-#include "matrix.h"
+/* analog connection settings */
+#define DISCHARGE_PIN D3
+#define ANALOG_PORT D4
+#define MUX_SEL_PINS \
+    { D0, D1, D2 }
 
-typedef struct {
-    uint16_t reset_pt;
-    uint16_t actuation_pt;
-} ec_config_t;
-
-void     ec_init(ec_config_t const* const ec_config);
-bool     ec_matrix_scan(matrix_row_t current_matrix[]);
-//void     ec_dprint_matrix(void);
-uint16_t ec_readkey_raw(uint8_t col, uint8_t row);
-bool     ec_update_key(matrix_row_t* current_row, matrix_row_t col, uint16_t sw_value, uint16_t reset_pt, uint16_t actuation_pt);
+/* calibrated thresholds, 4 bytes per key */
+#define EECONFIG_KB_DATA_SIZE 360
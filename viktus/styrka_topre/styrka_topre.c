@@ -29,9 +29,9 @@
 }*/
 
 void matrix_init_custom(void) {
-    ec_config_t ec_config = {.reset_pt = RESET_PT, .actuation_pt = ACTUATION_PT};
+    ec_threshold_t ec_defaults = {.reset_pt = RESET_PT, .actuation_pt = ACTUATION_PT};
 
-    ec_init(&ec_config);
+    ec_init(&ec_defaults);
 }
 
 bool matrix_scan_custom(matrix_row_t current_matrix[]) {
@@ -41,9 +41,43 @@ bool matrix_scan_custom(matrix_row_t current_matrix[]) {
     /*static int cnt = 0;
     if (cnt++ == 300) {
         cnt = 0;
-        ec_dprint_matrix();
+        ec_print_matrix();
         dprintf("\n");
     }*/
 
     return updated;
 }
+
+bool process_record_kb(uint16_t keycode, keyrecord_t *record) {
+    if (!process_record_user(keycode, record)) {
+        return false;
+    }
+    return process_record_ec(keycode, record);
+}
+
+// Modifying threshold values for overlapping pads
+void ec_threshold_kb(uint8_t row, uint8_t col, ec_threshold_t *threshold) {
+    switch (row) {
+        case 0:
+            switch (col) {
+                case 15: // lower threshold for split backspace:
+                case 16: // lower threshold for 2U backspace: 2U(37 rest, 62 btm)
+                    threshold->reset_pt     = 45;
+                    threshold->actuation_pt = 50;
+                    break;
+            }
+            break;
+        case 4:
+            switch (col) {
+                case 8: // Lower threshold for spacebar: 7U(37 rest, 63 btm)
+                    threshold->reset_pt     = 55;
+                    threshold->actuation_pt = 60;
+                    break;
+                case 13: // Lower threshold for right bottom mods: 1.5U(40 rest, 65 btm)
+                    threshold->reset_pt     = 47;
+                    threshold->actuation_pt = 53;
+                    break;
+            }
+            break;
+    }
+}